@@ -0,0 +1,40 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__ASM_OFFSETS_H
+#define __FIRESTARTER__ASM_OFFSETS_H
+
+/*
+ * offsets of the threaddata_t fields (see firestarter_global.h) that the assembler
+ * implementations in *_functions.S access, checked at compile time in work.c
+ */
+#define TD_ADDRMEM         16
+#define TD_ADDRHIGH        24
+#define TD_ITERATIONS      40
+#define TD_CHUNK           48
+#define TD_SHIFT_SEED      56
+#define TD_BUFFERSIZE      64
+#define TD_RESET_COUNT     96
+#define TD_RESULTS         120
+#define TD_RESULTS_SIZE    2048    /* 32 zmm registers of the AVX512 payloads */
+
+#endif
+
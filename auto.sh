@@ -14,22 +14,37 @@ SEC=25
 POW=105
 CTR=1
 
+# settings shared by all runs, the campaign overrides them per run
+cat > fsconfig <<-EOF
+	iterations = $NITER
+	pl1_window = $LSEC s
+	pl1_power = $LPOW W
+	pl2_window = $SEC
+	pl2_power = $POW W
+	pstate = $PSTATE
+	turbo = $TURBO
+	duty = $DUTY
+	partitions = $PART
+	maxfreq = $MAXFREQ GHz
+EOF
+
+# one line per run: output directory and the keys that differ from fsconfig
+rm -f campaign
+mkdir -p data/$EXP
 #for ((POW=60; POW <= 105; POW += 5));
 #do
 	for ((CTR=START; CTR<=END; CTR++));
 	do
-		echo -e "$NITER\n$LSEC\n$LPOW.0\n$SEC\n$POW.0\n$PSTATE\n$TURBO\n$DUTY\n$PART\n$MAXFREQ" > fsconfig
 		#DPATH="data/$EXP/$LPOW/$LSEC/$POW/$SEC/$PART/$DUTY"
 		DPATH="data/$EXP/$CTR/"
-		./FIRESTARTER --function 10 -q 1> pow
-		./check.sh 1> out
-		mkdir -p $DPATH
-		mv *.msrdat $DPATH
-		mv *.pow $DPATH 
-		mv out $DPATH
-		mv pow $DPATH 
-		#sleep 40s
+		echo "$DPATH pl1_power=${LPOW}W pl1_window=${LSEC}s pl2_power=${POW}W pl2_window=$SEC" >> campaign
 		echo -e "$EXP, $NITER, $LSTART, $LSEC, $SEC, $TURBO, $PSTATE, $PART, $DUTY" >> data/$EXP/README.txt
 	done
 #done
 
+# all runs in one process, each writes its traces, pow, and manifest to its directory
+./FIRESTARTER --function 10 -q --campaign=campaign || exit 1
+while read DPATH KEYS
+do
+	(cd $DPATH && $OLDPWD/check.sh 1> out)
+done < campaign
@@ -0,0 +1,364 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "autofunc.h"
+#include "work.h"
+#include "msrio.h"
+
+#define ENERGY_UNIT 0x606
+#define ENERGY_STATUS 0x611
+#define APERF 0xE8
+#define FIXED_CTR0 0x309
+#define FIXED_CTR_CTRL 0x38D
+
+/* buffer of the trials: share of the detected caches, the Haswell-EP sizes (1 thread per core) if not detected */
+#define TRIAL_L1_SIZE     32768
+#define TRIAL_L2_SIZE     262144
+#define TRIAL_L3_SIZE     2621440
+#define TRIAL_RAM_SIZE    104857600
+#define TRIAL_ALIGNMENT   64
+
+/* states of a trial, set by the master thread */
+#define TRIAL_INIT     0
+#define TRIAL_WARMUP   1
+#define TRIAL_MEASURE  2
+#define TRIAL_STOP     3
+
+/* scores of the functions, in the order of preference */
+#define METRIC_RAPL    0 /* package power in W */
+#define METRIC_IPC     1 /* instructions per cycle, if RAPL is not readable */
+#define METRIC_GFLOPS  2 /* estimated floating point performance, if no MSR is readable */
+
+static const char *metric_tags[] = {"rapl", "ipc", "gflops"};
+static const char *metric_units[] = {"W", "IPC", "GFLOPS"};
+
+extern unsigned int verbose;
+
+/*
+ * payload functions, the memory bandwidth functions are not considered
+ */
+static const struct {
+    int function;
+    const char *feature;
+    const char *name;
+} candidates[] = {
+    {FUNC_KNL_XEONPHI_AVX512_4T,  "AVX512",       "FUNC_KNL_XEONPHI_AVX512_4T"},
+    {FUNC_SKL_COREI_FMA_1T,       "FMA",          "FUNC_SKL_COREI_FMA_1T"},
+    {FUNC_SKL_COREI_FMA_2T,       "FMA",          "FUNC_SKL_COREI_FMA_2T"},
+    {FUNC_HSW_COREI_FMA_1T,       "FMA",          "FUNC_HSW_COREI_FMA_1T"},
+    {FUNC_HSW_COREI_FMA_2T,       "FMA",          "FUNC_HSW_COREI_FMA_2T"},
+    {FUNC_HSW_XEONEP_FMA_1T,      "FMA",          "FUNC_HSW_XEONEP_FMA_1T"},
+    {FUNC_HSW_XEONEP_FMA_2T,      "FMA",          "FUNC_HSW_XEONEP_FMA_2T"},
+    {FUNC_SNB_COREI_AVX_1T,       "AVX",          "FUNC_SNB_COREI_AVX_1T"},
+    {FUNC_SNB_COREI_AVX_2T,       "AVX",          "FUNC_SNB_COREI_AVX_2T"},
+    {FUNC_SNB_XEONEP_AVX_1T,      "AVX",          "FUNC_SNB_XEONEP_AVX_1T"},
+    {FUNC_SNB_XEONEP_AVX_2T,      "AVX",          "FUNC_SNB_XEONEP_AVX_2T"},
+    {FUNC_NHM_COREI_SSE2_1T,      "SSE2",         "FUNC_NHM_COREI_SSE2_1T"},
+    {FUNC_NHM_COREI_SSE2_2T,      "SSE2",         "FUNC_NHM_COREI_SSE2_2T"},
+    {FUNC_NHM_XEONEP_SSE2_1T,     "SSE2",         "FUNC_NHM_XEONEP_SSE2_1T"},
+    {FUNC_NHM_XEONEP_SSE2_2T,     "SSE2",         "FUNC_NHM_XEONEP_SSE2_2T"},
+    {FUNC_BLD_OPTERON_FMA4_1T,    "FMA4",         "FUNC_BLD_OPTERON_FMA4_1T"},
+    {FUNC_SKL_COREI_L1_FMA_1T,    "FMA",          "FUNC_SKL_COREI_L1_FMA_1T"},
+    {FUNC_SKL_COREI_L1_FMA_2T,    "FMA",          "FUNC_SKL_COREI_L1_FMA_2T"},
+    {FUNC_SKL_COREI_L2_FMA_1T,    "FMA",          "FUNC_SKL_COREI_L2_FMA_1T"},
+    {FUNC_SKL_COREI_L2_FMA_2T,    "FMA",          "FUNC_SKL_COREI_L2_FMA_2T"},
+    {FUNC_SKL_COREI_L3_FMA_1T,    "FMA",          "FUNC_SKL_COREI_L3_FMA_1T"},
+    {FUNC_SKL_COREI_L3_FMA_2T,    "FMA",          "FUNC_SKL_COREI_L3_FMA_2T"},
+    {FUNC_SKL_COREI_RAM_FMA_1T,   "FMA",          "FUNC_SKL_COREI_RAM_FMA_1T"},
+    {FUNC_SKL_COREI_RAM_FMA_2T,   "FMA",          "FUNC_SKL_COREI_RAM_FMA_2T"},
+    {FUNC_SKL_COREI_REG_FMA_1T,   "FMA",          "FUNC_SKL_COREI_REG_FMA_1T"},
+    {FUNC_SKL_COREI_REG_FMA_2T,   "FMA",          "FUNC_SKL_COREI_REG_FMA_2T"},
+    {FUNC_SKL_COREI_W128_FMA_1T,  "FMA",          "FUNC_SKL_COREI_W128_FMA_1T"},
+    {FUNC_SKL_COREI_W128_FMA_2T,  "FMA",          "FUNC_SKL_COREI_W128_FMA_2T"},
+    {FUNC_SKL_COREI_W512_FMA_1T,  "AVX512",       "FUNC_SKL_COREI_W512_FMA_1T"},
+    {FUNC_SKL_COREI_W512_FMA_2T,  "AVX512",       "FUNC_SKL_COREI_W512_FMA_2T"},
+    {FUNC_SKL_COREI_SP_FMA_1T,    "FMA",          "FUNC_SKL_COREI_SP_FMA_1T"},
+    {FUNC_SKL_COREI_SP_FMA_2T,    "FMA",          "FUNC_SKL_COREI_SP_FMA_2T"},
+    {FUNC_SKL_COREI_INT16_FMA_1T, "AVX2",         "FUNC_SKL_COREI_INT16_FMA_1T"},
+    {FUNC_SKL_COREI_INT16_FMA_2T, "AVX2",         "FUNC_SKL_COREI_INT16_FMA_2T"},
+    {FUNC_SKL_COREI_INT8_FMA_1T,  "AVX512_VNNI",  "FUNC_SKL_COREI_INT8_FMA_1T"},
+    {FUNC_SKL_COREI_INT8_FMA_2T,  "AVX512_VNNI",  "FUNC_SKL_COREI_INT8_FMA_2T"},
+    {FUNC_SKL_COREI_BF16_FMA_1T,  "AVX512_BF16",  "FUNC_SKL_COREI_BF16_FMA_1T"},
+    {FUNC_SKL_COREI_BF16_FMA_2T,  "AVX512_BF16",  "FUNC_SKL_COREI_BF16_FMA_2T"},
+    {FUNC_SKL_COREI_U288_FMA_1T,  "FMA",          "FUNC_SKL_COREI_U288_FMA_1T"},
+    {FUNC_SKL_COREI_U288_FMA_2T,  "FMA",          "FUNC_SKL_COREI_U288_FMA_2T"},
+    {FUNC_SKL_COREI_U576_FMA_1T,  "FMA",          "FUNC_SKL_COREI_U576_FMA_1T"},
+    {FUNC_SKL_COREI_U576_FMA_2T,  "FMA",          "FUNC_SKL_COREI_U576_FMA_2T"},
+    {FUNC_SKL_COREI_U1152_FMA_1T, "FMA",          "FUNC_SKL_COREI_U1152_FMA_1T"},
+    {FUNC_SKL_COREI_U1152_FMA_2T, "FMA",          "FUNC_SKL_COREI_U1152_FMA_2T"},
+};
+#define NUM_CANDIDATES (sizeof(candidates) / sizeof(candidates[0]))
+
+typedef struct trial
+{
+    threaddata_t threaddata;        /* function, buffer, and load variable of the trial thread */
+    pthread_t pthread;
+    volatile int *state;
+    volatile int ready;
+    int failed;
+    int read_energy;                /* set for the first thread of each package */
+    unsigned long long instructions; /* deltas of the measurement */
+    unsigned long long cycles;
+    unsigned long long energy;
+    unsigned long long iterations;
+    unsigned long long tsc;
+} trial_t;
+
+/*
+ * initializes the buffer for the function of the trial and runs it until the master thread stops the trial,
+ * counters are only read around the measurement, not during the warm-up
+ */
+static void *trial_thread(void *arg)
+{
+    trial_t *trial = (trial_t *)arg;
+    threaddata_t *mydata = &trial->threaddata;
+    uint64_t inst = 0, inst_a = 0, cycles = 0, cycles_a = 0, energy = 0, energy_a = 0;
+    unsigned long long tsc, iterations;
+
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+    cpu_set(mydata->cpu_id);
+#endif
+    msrio_write(mydata->cpu_id, FIXED_CTR_CTRL, 0x3UL | (0x1UL << 4) | (0x1UL << 8));
+    trial->failed = (call_init(mydata) != EXIT_SUCCESS);
+    trial->ready = 1;
+    if (trial->failed) return NULL;
+
+    while (*trial->state == TRIAL_INIT);
+    while (*trial->state == TRIAL_WARMUP) call_asm_work(mydata);
+
+    msrio_read(mydata->cpu_id, FIXED_CTR0, &inst);
+    msrio_read(mydata->cpu_id, APERF, &cycles);
+    if (trial->read_energy) msrio_read(mydata->cpu_id, ENERGY_STATUS, &energy);
+    iterations = mydata->iterations;
+    tsc = timestamp();
+
+    while (*trial->state == TRIAL_MEASURE) call_asm_work(mydata);
+
+    trial->tsc = timestamp() - tsc;
+    trial->iterations = mydata->iterations - iterations;
+    msrio_read(mydata->cpu_id, FIXED_CTR0, &inst_a);
+    msrio_read(mydata->cpu_id, APERF, &cycles_a);
+    if (trial->read_energy) msrio_read(mydata->cpu_id, ENERGY_STATUS, &energy_a);
+    trial->instructions = inst_a - inst;
+    trial->cycles = cycles_a - cycles;
+    // ENERGY_STATUS is a 32 bit counter
+    trial->energy = (energy_a - energy) & 0xFFFFFFFFUL;
+
+    return NULL;
+}
+
+static const char *candidate_name(int function)
+{
+    unsigned int i;
+
+    for (i = 0; i < NUM_CANDIDATES; i++) {
+        if (candidates[i].function == function) return candidates[i].name;
+    }
+
+    return NULL;
+}
+
+/*
+ * returns the first usable function of the cached ranking for signature, FUNC_NOT_DEFINED if there is none
+ */
+static int read_cache(const char *signature)
+{
+    char line[4096], *token, *save;
+    size_t len = strlen(signature);
+    int func = FUNC_NOT_DEFINED;
+    unsigned int i;
+    FILE *cache = fopen(AUTO_FUNCTION_CACHE, "r");
+
+    if (cache == NULL) return FUNC_NOT_DEFINED;
+    while ((func == FUNC_NOT_DEFINED) && fgets(line, sizeof(line), cache)) {
+        if (strncmp(line, signature, len) || (line[len] != ' ')) continue;
+        strtok_r(line, " \n", &save);              /* signature */
+        token = strtok_r(NULL, " \n", &save);      /* metric */
+        while ((func == FUNC_NOT_DEFINED) && (token = strtok_r(NULL, " \n", &save))) {
+            for (i = 0; i < NUM_CANDIDATES; i++) {
+                if ((candidates[i].function == atoi(token)) && feature_available((char *)candidates[i].feature)) {
+                    func = candidates[i].function;
+                    break;
+                }
+            }
+        }
+    }
+    fclose(cache);
+
+    return func;
+}
+
+/*
+ * replaces the ranking for signature in the cache file
+ */
+static void write_cache(const char *signature, int metric, unsigned int n, const int *ranking, const double *score)
+{
+    char line[4096];
+    size_t len = strlen(signature);
+    unsigned int i;
+    FILE *in, *out = fopen(AUTO_FUNCTION_CACHE ".tmp", "w");
+
+    if (out == NULL) {
+        fprintf(stderr, "Warning: --auto-function: cannot write %s\n", AUTO_FUNCTION_CACHE ".tmp");
+        return;
+    }
+    in = fopen(AUTO_FUNCTION_CACHE, "r");
+    if (in != NULL) {
+        while (fgets(line, sizeof(line), in)) {
+            if (strncmp(line, signature, len) || (line[len] != ' ')) fputs(line, out);
+        }
+        fclose(in);
+    }
+    fprintf(out, "%s %s", signature, metric_tags[metric]);
+    for (i = 0; i < n; i++) fprintf(out, " %i:%.3f", ranking[i], score[i]);
+    fprintf(out, "\n");
+    fclose(out);
+    if (rename(AUTO_FUNCTION_CACHE ".tmp", AUTO_FUNCTION_CACHE)) {
+        fprintf(stderr, "Warning: --auto-function: cannot write %s\n", AUTO_FUNCTION_CACHE);
+    }
+}
+
+int auto_function(cpu_info_t *cpuinfo, unsigned long long *cpu_bind, unsigned int num_threads, unsigned int trial_ms)
+{
+    char signature[64];
+    int ranking[NUM_CANDIDATES], func, metric, *pkg;
+    double score[NUM_CANDIDATES], energy_unit = 0.0, s;
+    unsigned long long instructions, cycles, buffersizeMem, load = LOAD_HIGH;
+    unsigned int buffersize[MAX_CACHELEVELS] = {TRIAL_L1_SIZE, TRIAL_L2_SIZE, TRIAL_L3_SIZE};
+    uint64_t unit = 0, value;
+    unsigned int c, i, j, t, n = 0;
+    volatile int state;
+    trial_t *trials;
+
+    snprintf(signature, sizeof(signature), "%s-%u-%u-%u", cpuinfo->vendor, cpuinfo->family, cpuinfo->model, cpuinfo->stepping);
+    func = read_cache(signature);
+    if (func != FUNC_NOT_DEFINED) {
+        if (verbose) printf("  --auto-function: using function %i (%s) from the ranking for %s in %s\n",
+                            func, candidate_name(func), signature, AUTO_FUNCTION_CACHE);
+        return func;
+    }
+
+    if ((msrio_read(cpu_bind[0], ENERGY_UNIT, &unit) == 0) && (unit != 0)) {
+        metric = METRIC_RAPL;
+        energy_unit = 1.0 / (0x1 << ((unit & 0x1F00) >> 8));
+    }
+    else if (msrio_read(cpu_bind[0], FIXED_CTR0, &value) == 0) metric = METRIC_IPC;
+    else metric = METRIC_GFLOPS;
+
+    /* the trials run on all hardware threads */
+    cache_buffersizes(cpuinfo, cpuinfo->num_threads_per_core ? cpuinfo->num_threads_per_core : 1, buffersize);
+    buffersizeMem = 2 * buffersize[0] + buffersize[1] + buffersize[2] + TRIAL_RAM_SIZE + TRIAL_ALIGNMENT + 2 * sizeof(unsigned long long);
+
+    trials = (trial_t *) _mm_malloc(num_threads * sizeof(trial_t), TRIAL_ALIGNMENT);
+    pkg = (int *) malloc(num_threads * sizeof(int));
+    if ((trials == NULL) || (pkg == NULL)) {
+        fprintf(stderr, "Error: --auto-function: allocation of the trial threads failed\n");
+        exit(127);
+    }
+    memset(trials, 0, num_threads * sizeof(trial_t));
+    for (t = 0; t < num_threads; t++) {
+        trials[t].threaddata.bufferMem = _mm_malloc(buffersizeMem, TRIAL_ALIGNMENT);
+        if (trials[t].threaddata.bufferMem == NULL) {
+            fprintf(stderr, "Error: --auto-function: allocation of the trial buffers failed\n");
+            exit(127);
+        }
+        pkg[t] = get_pkg(cpu_bind[t]);
+        trials[t].read_energy = 1;
+        for (j = 0; j < t; j++) {
+            if (pkg[j] == pkg[t]) trials[t].read_energy = 0;
+        }
+    }
+
+    if (verbose) printf("  --auto-function: running every usable function for %u ms, ranked by %s\n", trial_ms,
+                        (metric == METRIC_RAPL) ? "package power" : ((metric == METRIC_IPC) ? "IPC, RAPL is not available" : "GFLOPS, RAPL and IPC are not available"));
+
+    for (c = 0; c < NUM_CANDIDATES; c++) {
+        if (!feature_available((char *)candidates[c].feature)) continue;
+
+        state = TRIAL_INIT;
+        for (t = 0; t < num_threads; t++) {
+            threaddata_t *mydata = &trials[t].threaddata;
+            mydata->FUNCTION = candidates[c].function;
+            mydata->cpu_id = cpu_bind[t];
+            mydata->thread_id = t;
+            mydata->addrMem = (unsigned long long)(mydata->bufferMem);
+            mydata->addrHigh = (unsigned long long)&load;
+            mydata->buffersizeMem = buffersizeMem;
+            for (i = 0; i < MAX_CACHELEVELS; i++) mydata->buffersize[i] = buffersize[i];
+            mydata->buffersize[MAX_CACHELEVELS] = TRIAL_RAM_SIZE;
+            mydata->alignment = TRIAL_ALIGNMENT;
+            mydata->iterations = 0;
+            mydata->chunk = DEFAULT_CHUNK;
+            mydata->shift_seed = DEFAULT_SHIFT_SEED;
+            trials[t].state = &state;
+            trials[t].ready = 0;
+            pthread_create(&trials[t].pthread, NULL, trial_thread, (void *)&trials[t]);
+        }
+        for (t = 0; t < num_threads; t++) while (!trials[t].ready);
+
+        state = TRIAL_WARMUP;
+        usleep(trial_ms * 250);
+        state = TRIAL_MEASURE;
+        usleep(trial_ms * 1000);
+        state = TRIAL_STOP;
+
+        s = 0.0;
+        instructions = cycles = 0;
+        for (t = 0; t < num_threads; t++) {
+            pthread_join(trials[t].pthread, NULL);
+            if (trials[t].failed || (trials[t].tsc == 0)) continue;
+            instructions += trials[t].instructions;
+            cycles += trials[t].cycles;
+            if ((metric == METRIC_RAPL) && trials[t].read_energy) s += (double)trials[t].energy * energy_unit * (double)cpuinfo->clockrate / (double)trials[t].tsc;
+            if (metric == METRIC_GFLOPS) s += (double)trials[t].threaddata.flops * (double)trials[t].iterations * (double)cpuinfo->clockrate / (double)trials[t].tsc * 0.000000001;
+        }
+        if ((metric == METRIC_IPC) && cycles) s = (double)instructions / (double)cycles;
+        if (verbose) printf("    - function %2i (%s): %.2f %s\n", candidates[c].function, candidates[c].name, s, metric_units[metric]);
+
+        /* insert into the ranking, highest score first */
+        for (i = n++; (i > 0) && (score[i - 1] < s); i--) {
+            ranking[i] = ranking[i - 1];
+            score[i] = score[i - 1];
+        }
+        ranking[i] = candidates[c].function;
+        score[i] = s;
+    }
+
+    for (t = 0; t < num_threads; t++) _mm_free(trials[t].threaddata.bufferMem);
+    _mm_free(trials);
+    free(pkg);
+
+    if ((n == 0) || (score[0] <= 0.0)) {
+        fprintf(stderr, "Warning: --auto-function: no function could be measured\n");
+        return FUNC_NOT_DEFINED;
+    }
+    write_cache(signature, metric, n, ranking, score);
+    if (verbose) printf("  --auto-function: selected function %i (%s), ranking saved in %s\n\n", ranking[0], candidate_name(ranking[0]), AUTO_FUNCTION_CACHE);
+
+    return ranking[0];
+}
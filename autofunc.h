@@ -0,0 +1,46 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__AUTOFUNC_H
+#define __FIRESTARTER__AUTOFUNC_H
+
+#include "firestarter_global.h"
+
+/*
+ * --auto-function: default duration of the measurement of each function in ms,
+ * every trial is preceded by a warm-up of a quarter of that time
+ */
+#define AUTO_FUNCTION_MS       500
+
+/*
+ * ranking of the functions per CPUID signature, read from and written to the working directory
+ */
+#define AUTO_FUNCTION_CACHE    "fsauto"
+
+/*
+ * runs every payload function that is usable on this processor for trial_ms on the given CPUs and
+ * returns the one with the highest package power (RAPL), or the highest IPC if RAPL is not available,
+ * the ranking is cached in AUTO_FUNCTION_CACHE, returns FUNC_NOT_DEFINED if no function could be measured
+ */
+extern int auto_function(cpu_info_t *cpuinfo, unsigned long long *cpu_bind, unsigned int num_threads, unsigned int trial_ms);
+
+#endif
+
@@ -44,10 +44,16 @@ int asm_work_snb_corei_avx_1t(threaddata_t* threaddata) __attribute__((noinline)
 int asm_work_snb_corei_avx_1t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -63,12 +69,14 @@ int asm_work_snb_corei_avx_1t(threaddata_t* threaddata)
          *   - r12:           stores cacheline width as increment for buffer addresses
          *   - r13:           stores address of shared variable that controls load level
          *   - r14:           stores iteration counter
+         *   - r15:           stores number of iterations left in this call
          *   - mm*,xmm*,ymm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize AVX-Registers for Addition
         "vmovapd 0(%%rax), %%ymm0;"
@@ -116,14 +124,14 @@ int asm_work_snb_corei_avx_1t(threaddata_t* threaddata)
         "vinsertf128 $1, %%xmm15, %%ymm15, %%ymm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $32768, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $262144, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $1572864, %%rdi;" // address for RAM-buffer
-        "movabs $32, %%r8;" // reset-counter for L2-buffer with 100 cache lines accessed per loop (200.0 KB)
-        "movabs $491, %%r9;" // reset-counter for L3-buffer with 40 cache lines accessed per loop (1227.5 KB)
-        "movabs $81920, %%r10;" // reset-counter for RAM-buffer with 20 cache lines accessed per loop (102400.0 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 100 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 40 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 20 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_snb_corei_avx_1t:"
@@ -1642,38 +1650,36 @@ int asm_work_snb_corei_avx_1t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_snb_corei_avx_1t;"
-        "movabs $81920, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $1572864, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_snb_corei_avx_1t:"
         //reset L2-Cache counter
         "sub $1, %%r8;"
         "jnz _work_no_L2_reset_snb_corei_avx_1t;"
-        "movabs $32, %%r8;"
+        "mov %[l2_count], %%r8;"
         "mov %%rax, %%rcx;"
-        "add $32768, %%rcx;"
+        "add %[l1_size], %%rcx;"
         "_work_no_L2_reset_snb_corei_avx_1t:"
         //reset L3-Cache counter
         "sub $1, %%r9;"
         "jnz _work_no_L3_reset_snb_corei_avx_1t;"
-        "movabs $491, %%r9;"
+        "mov %[l3_count], %%r9;"
         "mov %%rax, %%rdx;"
-        "add $262144, %%rdx;"
+        "add %[l2_size], %%rdx;"
         "_work_no_L3_reset_snb_corei_avx_1t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
-		// This is the FWQ code
-		"mov %%r14, %%r11;"
-		"subq $100, %%r11;"
-		"jns _work_done_snb_corei_avx_1t;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_snb_corei_avx_1t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_snb_corei_avx_1t;"
-		"_work_done_snb_corei_avx_1t:"
+        "_work_done_snb_corei_avx_1t:"
         "movq %%r14, %%rax;" // restore iteration counter
-		"movabs $0, %%r14;"
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -1686,10 +1692,16 @@ int asm_work_snb_corei_avx_2t(threaddata_t* threaddata) __attribute__((noinline)
 int asm_work_snb_corei_avx_2t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -1705,12 +1717,14 @@ int asm_work_snb_corei_avx_2t(threaddata_t* threaddata)
          *   - r12:           stores cacheline width as increment for buffer addresses
          *   - r13:           stores address of shared variable that controls load level
          *   - r14:           stores iteration counter
+         *   - r15:           stores number of iterations left in this call
          *   - mm*,xmm*,ymm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize AVX-Registers for Addition
         "vmovapd 0(%%rax), %%ymm0;"
@@ -1758,14 +1772,14 @@ int asm_work_snb_corei_avx_2t(threaddata_t* threaddata)
         "vinsertf128 $1, %%xmm15, %%ymm15, %%ymm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $131072, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $786432, %%rdi;" // address for RAM-buffer
-        "movabs $32, %%r8;" // reset-counter for L2-buffer with 50 cache lines accessed per loop (100.0 KB)
-        "movabs $491, %%r9;" // reset-counter for L3-buffer with 20 cache lines accessed per loop (613.75 KB)
-        "movabs $81920, %%r10;" // reset-counter for RAM-buffer with 10 cache lines accessed per loop (51200.0 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 50 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 20 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 10 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_snb_corei_avx_2t:"
@@ -2529,32 +2543,36 @@ int asm_work_snb_corei_avx_2t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_snb_corei_avx_2t;"
-        "movabs $81920, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $786432, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_snb_corei_avx_2t:"
         //reset L2-Cache counter
         "sub $1, %%r8;"
         "jnz _work_no_L2_reset_snb_corei_avx_2t;"
-        "movabs $32, %%r8;"
+        "mov %[l2_count], %%r8;"
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;"
+        "add %[l1_size], %%rcx;"
         "_work_no_L2_reset_snb_corei_avx_2t:"
         //reset L3-Cache counter
         "sub $1, %%r9;"
         "jnz _work_no_L3_reset_snb_corei_avx_2t;"
-        "movabs $491, %%r9;"
+        "mov %[l3_count], %%r9;"
         "mov %%rax, %%rdx;"
-        "add $131072, %%rdx;"
+        "add %[l2_size], %%rdx;"
         "_work_no_L3_reset_snb_corei_avx_2t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_snb_corei_avx_2t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_snb_corei_avx_2t;"
+        "_work_done_snb_corei_avx_2t:"
         "movq %%r14, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -2568,11 +2586,16 @@ int asm_work_snb_xeonep_avx_1t(threaddata_t* threaddata) __attribute__((noinline
 int asm_work_snb_xeonep_avx_1t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
-	threaddata->iterations = 0;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -2588,12 +2611,14 @@ int asm_work_snb_xeonep_avx_1t(threaddata_t* threaddata)
          *   - r12:           stores cacheline width as increment for buffer addresses
          *   - r13:           stores address of shared variable that controls load level
          *   - r14:           stores iteration counter
+         *   - r15:           stores number of iterations left in this call
          *   - mm*,xmm*,ymm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize AVX-Registers for Addition
         "vmovapd 0(%%rax), %%ymm0;"
@@ -2641,14 +2666,14 @@ int asm_work_snb_xeonep_avx_1t(threaddata_t* threaddata)
         "vinsertf128 $1, %%xmm15, %%ymm15, %%ymm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $32768, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $262144, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $2621440, %%rdi;" // address for RAM-buffer
-        "movabs $29, %%r8;" // reset-counter for L2-buffer with 110 cache lines accessed per loop (199.38 KB)
-        "movabs $1489, %%r9;" // reset-counter for L3-buffer with 22 cache lines accessed per loop (2047.38 KB)
-        "movabs $49648, %%r10;" // reset-counter for RAM-buffer with 33 cache lines accessed per loop (102399.0 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 110 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 22 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 33 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_snb_xeonep_avx_1t:"
@@ -4142,38 +4167,36 @@ int asm_work_snb_xeonep_avx_1t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_snb_xeonep_avx_1t;"
-        "movabs $49648, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $2621440, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_snb_xeonep_avx_1t:"
         //reset L2-Cache counter
         "sub $1, %%r8;"
         "jnz _work_no_L2_reset_snb_xeonep_avx_1t;"
-        "movabs $29, %%r8;"
+        "mov %[l2_count], %%r8;"
         "mov %%rax, %%rcx;"
-        "add $32768, %%rcx;"
+        "add %[l1_size], %%rcx;"
         "_work_no_L2_reset_snb_xeonep_avx_1t:"
         //reset L3-Cache counter
         "sub $1, %%r9;"
         "jnz _work_no_L3_reset_snb_xeonep_avx_1t;"
-        "movabs $1489, %%r9;"
+        "mov %[l3_count], %%r9;"
         "mov %%rax, %%rdx;"
-        "add $262144, %%rdx;"
+        "add %[l2_size], %%rdx;"
         "_work_no_L3_reset_snb_xeonep_avx_1t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
-		// This is the FWQ code
-		"mov %%r14, %%r11;"
-		"subq $100, %%r11;"
-		"jns _work_done_snb_xeonep_avx_1t;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_snb_xeonep_avx_1t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_snb_xeonep_avx_1t;"
-		"_work_done_snb_xeonep_avx_1t:"
+        "_work_done_snb_xeonep_avx_1t:"
         "movq %%r14, %%rax;" // restore iteration counter
-		"movabs $0, %%r14;"
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -4186,10 +4209,16 @@ int asm_work_snb_xeonep_avx_2t(threaddata_t* threaddata) __attribute__((noinline
 int asm_work_snb_xeonep_avx_2t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -4205,12 +4234,14 @@ int asm_work_snb_xeonep_avx_2t(threaddata_t* threaddata)
          *   - r12:           stores cacheline width as increment for buffer addresses
          *   - r13:           stores address of shared variable that controls load level
          *   - r14:           stores iteration counter
+         *   - r15:           stores number of iterations left in this call
          *   - mm*,xmm*,ymm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize AVX-Registers for Addition
         "vmovapd 0(%%rax), %%ymm0;"
@@ -4258,14 +4289,14 @@ int asm_work_snb_xeonep_avx_2t(threaddata_t* threaddata)
         "vinsertf128 $1, %%xmm15, %%ymm15, %%ymm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $131072, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $1310720, %%rdi;" // address for RAM-buffer
-        "movabs $32, %%r8;" // reset-counter for L2-buffer with 50 cache lines accessed per loop (100.0 KB)
-        "movabs $1638, %%r9;" // reset-counter for L3-buffer with 10 cache lines accessed per loop (1023.75 KB)
-        "movabs $54613, %%r10;" // reset-counter for RAM-buffer with 15 cache lines accessed per loop (51199.69 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 50 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 10 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 15 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_snb_xeonep_avx_2t:"
@@ -4949,32 +4980,36 @@ int asm_work_snb_xeonep_avx_2t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_snb_xeonep_avx_2t;"
-        "movabs $54613, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $1310720, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_snb_xeonep_avx_2t:"
         //reset L2-Cache counter
         "sub $1, %%r8;"
         "jnz _work_no_L2_reset_snb_xeonep_avx_2t;"
-        "movabs $32, %%r8;"
+        "mov %[l2_count], %%r8;"
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;"
+        "add %[l1_size], %%rcx;"
         "_work_no_L2_reset_snb_xeonep_avx_2t:"
         //reset L3-Cache counter
         "sub $1, %%r9;"
         "jnz _work_no_L3_reset_snb_xeonep_avx_2t;"
-        "movabs $1638, %%r9;"
+        "mov %[l3_count], %%r9;"
         "mov %%rax, %%rdx;"
-        "add $131072, %%rdx;"
+        "add %[l2_size], %%rdx;"
         "_work_no_L3_reset_snb_xeonep_avx_2t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_snb_xeonep_avx_2t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_snb_xeonep_avx_2t;"
+        "_work_done_snb_xeonep_avx_2t:"
         "movq %%r14, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
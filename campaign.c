@@ -0,0 +1,230 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+
+#include "firestarter_global.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "campaign.h"
+#include "fsconfig.h"
+#include "work.h"
+
+/*
+ * creates dir and its parents (mkdir -p)
+ */
+static int make_dirs(const char *dir)
+{
+    char path[CAMPAIGN_MAX_NAME + 2], *sep;
+
+    snprintf(path, sizeof(path), "%s", dir);
+    for (sep = strchr(path + 1, '/'); ; sep = strchr(sep + 1, '/')) {
+        if (sep) *sep = '\0';
+        if ((mkdir(path, 0755) != 0) && (errno != EEXIST)) {
+            fprintf(stderr, "Error: cannot create the directory %s: %s\n", path, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        if (sep == NULL) break;
+        *sep = '/';
+        if (sep[1] == '\0') break;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int campaign_read(campaign_t *campaign, const char *file, const fsconfig_t *base)
+{
+    FILE *stream = fopen(file, "r");
+    char line[4096], where[300], *name, *assignment, *comment, *save;
+    unsigned int lineno = 0, max_runs = 0, r;
+    campaign_run_t *run;
+
+    memset(campaign, 0, sizeof(campaign_t));
+    campaign->file = file;
+    if (stream == NULL) {
+        fprintf(stderr, "Error: cannot open the campaign %s\n", file);
+        return EXIT_FAILURE;
+    }
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        lineno++;
+        comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        name = strtok_r(line, " \t\r\n", &save);
+        if (name == NULL) continue;
+        snprintf(where, sizeof(where), "%s:%u", file, lineno);
+        if ((strchr(name, '=') != NULL) || (strlen(name) > CAMPAIGN_MAX_NAME)) {
+            fprintf(stderr, "Error: %s: expected NAME KEY=VALUE ..., the name has at most %d characters\n", where, CAMPAIGN_MAX_NAME);
+            goto error;
+        }
+        for (r = 0; r < campaign->num_runs; r++) {
+            if (strcmp(campaign->runs[r].name, name) == 0) {
+                fprintf(stderr, "Error: %s: the run %s is defined twice, its output would be overwritten\n", where, name);
+                goto error;
+            }
+        }
+        if (campaign->num_runs == max_runs) {
+            max_runs = max_runs ? 2 * max_runs : 64;
+            campaign->runs = realloc(campaign->runs, max_runs * sizeof(campaign_run_t));
+            if (campaign->runs == NULL) {
+                fprintf(stderr, "Error: cannot allocate the campaign\n");
+                goto error;
+            }
+        }
+        run = &campaign->runs[campaign->num_runs];
+        snprintf(run->name, sizeof(run->name), "%s", name);
+        snprintf(run->dir, sizeof(run->dir), "%s%s", name, (name[strlen(name) - 1] == '/') ? "" : "/");
+        run->config = *base;
+        while ((assignment = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+            if (fsconfig_set(&run->config, assignment, where) != EXIT_SUCCESS) goto error;
+        }
+        if (fsconfig_validate(&run->config) != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: %s: invalid configuration of the run %s\n", where, name);
+            goto error;
+        }
+        campaign->num_runs++;
+    }
+    fclose(stream);
+    if (campaign->num_runs == 0) {
+        fprintf(stderr, "Error: the campaign %s has no runs\n", file);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+
+error:
+    fclose(stream);
+    free(campaign->runs);
+    campaign->runs = NULL;
+    campaign->num_runs = 0;
+    return EXIT_FAILURE;
+}
+
+static void print_time(FILE *stream, const char *key, const struct timeval *tv)
+{
+    char buf[64];
+    struct tm tm;
+
+    localtime_r(&tv->tv_sec, &tm);
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+    fprintf(stream, "# %s: %s.%03ld\n", key, buf, (long) (tv->tv_usec / 1000));
+}
+
+/*
+ * manifest of a completed run: description as comments, then the configuration that it used
+ */
+static void write_manifest(const campaign_t *campaign, unsigned int r, const mydata_t *data,
+                           const struct timeval *start, const struct timeval *stop, unsigned long long iterations)
+{
+    const campaign_run_t *run = &campaign->runs[r];
+    char path[sizeof(run->dir) + sizeof(CAMPAIGN_MANIFEST)];
+    FILE *stream;
+
+    snprintf(path, sizeof(path), "%s%s", run->dir, CAMPAIGN_MANIFEST);
+    stream = fopen(path, "w");
+    if (stream == NULL) {
+        fprintf(stderr, "Warning: cannot write %s\n", path);
+        return;
+    }
+    fprintf(stream, "# run: %s (%u of %u in %s)\n", run->name, r + 1, campaign->num_runs, campaign->file);
+    print_time(stream, "start", start);
+    print_time(stream, "stop", stop);
+    fprintf(stream, "# duration: %.3f s\n", (double) (stop->tv_sec - start->tv_sec) + (double) (stop->tv_usec - start->tv_usec) / 1000000.0);
+    fprintf(stream, "# function: %u\n", data->threaddata[0].FUNCTION);
+    fprintf(stream, "# threads: %u\n", data->num_threads);
+    fprintf(stream, "# payload iterations: %llu\n", iterations);
+    fsconfig_print(stream, &run->config);
+    fclose(stream);
+}
+
+int campaign_execute(campaign_t *campaign, mydata_t *data, unsigned long long *loadvar, const unsigned long *thread_pstate)
+{
+    struct timeval start, stop;
+    unsigned long long iterations;
+    unsigned int r, t;
+    char path[CAMPAIGN_MAX_NAME + 2 + sizeof(CAMPAIGN_OUTPUT)];
+    int stdout_fd = dup(STDOUT_FILENO), fd, result = EXIT_SUCCESS;
+
+    data->campaign = 1;
+    for (r = 0; r < campaign->num_runs; r++) {
+        campaign_run_t *run = &campaign->runs[r];
+
+        if (make_dirs(run->dir) != EXIT_SUCCESS) {
+            result = EXIT_FAILURE;
+            break;
+        }
+        fprintf(stderr, "campaign: run %u of %u: %s\n", r + 1, campaign->num_runs, run->name);
+
+        /* the standard output of the workers goes to the directory of the run */
+        snprintf(path, sizeof(path), "%s%s", run->dir, CAMPAIGN_OUTPUT);
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            fprintf(stderr, "Error: cannot write %s: %s\n", path, strerror(errno));
+            result = EXIT_FAILURE;
+            break;
+        }
+        fflush(stdout);
+        dup2(fd, STDOUT_FILENO);
+        close(fd);
+
+        iterations = 0;
+        for (t = 0; t < data->num_threads; t++) {
+            data->threaddata[t].config = &run->config;
+            data->threaddata[t].pstate = (thread_pstate && (thread_pstate[t] != PSTATE_UNLISTED)) ? thread_pstate[t] : run->config.pstate;
+            iterations -= data->threaddata[t].phase_iterations[PHASE_PAYLOAD];
+        }
+        data->run_dir = run->dir;
+        data->run_done = 0;
+        gettimeofday(&start, NULL);
+        _work(data, loadvar);
+
+        /* the threads leave the experiment loop after their output is written */
+        while ((data->run_done < data->num_threads) && (*((volatile unsigned long long *) loadvar) != LOAD_STOP)) usleep(1000);
+        gettimeofday(&stop, NULL);
+        fflush(stdout);
+        dup2(stdout_fd, STDOUT_FILENO);
+        if (data->run_done < data->num_threads) {
+            fprintf(stderr, "campaign: stopped during run %s\n", run->name);
+            result = EXIT_FAILURE;
+            break;
+        }
+        for (t = 0; t < data->num_threads; t++) iterations += data->threaddata[t].phase_iterations[PHASE_PAYLOAD];
+        write_manifest(campaign, r, data, &start, &stop, iterations);
+
+        /* park the threads, the next _work() starts them again */
+        for (t = 0; t < data->num_threads; t++) {
+            data->ack = 0;
+            data->thread_comm[t] = THREAD_WAIT;
+            while (!data->ack);
+        }
+        data->ack = 0;
+    }
+    close(stdout_fd);
+
+    for (t = 0; t < data->num_threads; t++) data->thread_comm[t] = THREAD_STOP;
+
+    return result;
+}
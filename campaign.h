@@ -0,0 +1,69 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__CAMPAIGN_H
+#define __FIRESTARTER__CAMPAIGN_H
+
+#include "firestarter_global.h"
+
+/*
+ * campaign (--campaign=FILE): runs of the experiment loop that one process executes back to back with the
+ * same threads and buffers, one run per line:
+ *   NAME KEY=VALUE [KEY=VALUE ...]
+ * the keys override the run configuration (fsconfig), NAME is the output directory of the run (created
+ * if needed, may contain /), # starts a comment
+ */
+#define CAMPAIGN_MAX_NAME      255
+
+/*
+ * files in the output directory of each run: the description of the run followed by its configuration
+ * (usable with --config), and the standard output of the run
+ */
+#define CAMPAIGN_MANIFEST      "manifest"
+#define CAMPAIGN_OUTPUT        "pow"
+
+typedef struct campaign_run {
+    char name[CAMPAIGN_MAX_NAME + 1];
+    char dir[CAMPAIGN_MAX_NAME + 2];    /* name with a trailing / */
+    fsconfig_t config;
+} campaign_run_t;
+
+typedef struct campaign {
+    const char *file;
+    campaign_run_t *runs;
+    unsigned int num_runs;
+} campaign_t;
+
+/*
+ * reads the runs in file on top of base and validates all of them,
+ * returns EXIT_SUCCESS or EXIT_FAILURE after printing the reason
+ */
+extern int campaign_read(campaign_t *campaign, const char *file, const fsconfig_t *base);
+
+/*
+ * runs the campaign with the threads in data, which have to be initialized and waiting for THREAD_WORK,
+ * thread_pstate are the PERF_CTL targets of --pstate (NULL or PSTATE_UNLISTED = pstate of each run), the threads are stopped
+ * at the end, returns EXIT_SUCCESS or EXIT_FAILURE if a run could not be completed
+ */
+extern int campaign_execute(campaign_t *campaign, mydata_t *data, unsigned long long *loadvar, const unsigned long *thread_pstate);
+
+#endif
+
@@ -20,14 +20,14 @@
 # Contact: daniel.hackenberg@tu-dresden.de
 ###############################################################################
 
-import os, sys, getopt, datetime, importlib
+import os, sys, getopt, datetime, importlib, copy, re, subprocess
 try:
     from configparser import ConfigParser
 except ImportError:
     from ConfigParser import ConfigParser
 
 # import templates
-from templates import firestarter_global_h, Makefile, work_c, work_h, main_c, main_win64_c
+from templates import firestarter_global_h, Makefile, work_c, work_h, main_c, main_win64_c, util, asm_functions_s
 
 def usage():
     print("code-generator.py generates source code of FIRESTARTER")
@@ -37,12 +37,13 @@ def usage():
     print("-c|--enable-cuda     enable CUDA support")
     print("-m|--enable-mac      enable Mac O/S support")
     print("-w|--enable-win      enable windows support")
+    print("-r|--report          print the code size of the generated loops (requires $CC or gcc, and nm)")
     print("If one of the --enable-* arguments is used it overrides all the feature")
     print("selections in the config file, i.e., if one feature is added on the command line,")
     print("features that are enabled by default have to be added to the command as well.")
 
 try:
-    opts,args = getopt.getopt(sys.argv[1:], "hvcmw", ["help","verbose","enable-cuda","enable-mac","enable-win"])
+    opts,args = getopt.getopt(sys.argv[1:], "hvcmwr", ["help","verbose","enable-cuda","enable-mac","enable-win","report"])
 except getopt.GetoptError as err:
     print(str(err)) # will print something like "option -a not recognized"
     usage()
@@ -64,6 +65,7 @@ architectures = []
 templates = []
 families = []
 verbose = False
+report = False
 feature_override = False
 features = [False,False,False]
 date = datetime.datetime.now()
@@ -86,6 +88,8 @@ for o, a in opts:
     elif o in ("-m", "--enable-mac"):
         feature_override = True
         features[2] = True
+    elif o in ("-r", "--report"):
+        report = True
     else:
         assert False, "unhandled option"
 
@@ -154,6 +158,28 @@ for each in architectures:
         sys.exit(2)
     each.lines=int(cfg.get(each.name,'lines'))
 
+    # optional list of instruction groups that get a variant of their own, which uses only that group
+    each.isolate=[]
+    if cfg.has_option(each.name,'isolate'):
+        each.isolate=[x.strip() for x in cfg.get(each.name,'isolate').split(',')]
+
+    # optional SIMD widths in bit that get a variant of their own, which uses the same instruction groups
+    each.widths=[]
+    if cfg.has_option(each.name,'widths'):
+        each.widths=[int(x.strip()) for x in cfg.get(each.name,'widths').split(',')]
+    each.width=256
+
+    # optional data types that get a variant of their own, which uses the respective instructions instead of vfmadd231pd
+    each.datatypes=[]
+    if cfg.has_option(each.name,'datatypes'):
+        each.datatypes=[x.strip() for x in cfg.get(each.name,'datatypes').split(',')]
+    each.datatype='dp'
+    each.feature=''
+
+    each.unroll=[]
+    if cfg.has_option(each.name,'unroll'):
+        each.unroll=[int(x.strip()) for x in cfg.get(each.name,'unroll').split(',')]
+
     # settings that are currently identical for all supported architectures
     # - coverage:     defines percentage of capacity utilization of buffers for each level (L1/L2/L3/RAM)
     # - cl_size:      cache line width in byte
@@ -163,6 +189,78 @@ for each in architectures:
     each.ram_cover=1.0
     each.cl_size=64
 
+# create the cache-level-isolated, SIMD width, and data type variants, e.g., skl_corei_l1_fma_1t for group L1_L of Skylake
+# - they are appended after all other architectures, so that existing function IDs do not change
+# - they have no cpu_family, i.e., they are never selected automatically
+# features required by the data types in addition to FMA
+datatype_features = {'sp': '', 'int16': 'avx2', 'int8': 'avx512_vnni', 'bf16': 'avx512_bf16'}
+variants = []
+for each in architectures:
+    for group in each.isolate:
+        variant = copy.copy(each)
+        variant.name = each.name+' ('+group+' only)'
+        variant.model = each.model+'_'+group.split('_')[0].lower()
+        variant.cpu_family = ''
+        variant.cpu_model = []
+        variant.instr_groups = [group]
+        variant.proportion = ['1']
+        variant.isolate = []
+        variant.widths = []
+        variant.datatypes = []
+        variant.unroll = []
+        variants.append(variant)
+    # SIMD width variants, e.g., skl_corei_w512_fma_1t, only supported by the fma template
+    for width in each.widths:
+        if each.isa != ['fma'] or width not in (128,512):
+            print("Error: invalid setting for \"widths\" in architecture "+each.name)
+            sys.exit(2)
+        variant = copy.copy(each)
+        variant.name = each.name+' ('+str(width)+' bit)'
+        variant.model = each.model+'_w'+str(width)
+        variant.cpu_family = ''
+        variant.cpu_model = []
+        variant.isolate = []
+        variant.widths = []
+        variant.datatypes = []
+        variant.unroll = []
+        variant.width = width
+        if width == 512:
+            variant.feature = 'avx512'
+        variants.append(variant)
+    # data type variants, e.g., skl_corei_sp_fma_1t, only supported by the fma template
+    for datatype in each.datatypes:
+        if each.isa != ['fma'] or datatype not in datatype_features:
+            print("Error: invalid setting for \"datatypes\" in architecture "+each.name)
+            sys.exit(2)
+        variant = copy.copy(each)
+        variant.name = each.name+' ('+datatype+')'
+        variant.model = each.model+'_'+datatype
+        variant.cpu_family = ''
+        variant.cpu_model = []
+        variant.isolate = []
+        variant.widths = []
+        variant.datatypes = []
+        variant.unroll = []
+        variant.datatype = datatype
+        variant.feature = datatype_features[datatype]
+        variants.append(variant)
+    for lines in each.unroll:
+        if lines < len(util.generate_sequence(each.instr_groups,each.proportion))*max([int(x) for x in each.threads]):
+            print("Error: invalid setting for \"unroll\" in architecture "+each.name+", the sequence does not fit into "+str(lines)+" lines")
+            sys.exit(2)
+        variant = copy.copy(each)
+        variant.name = each.name+' ('+str(lines)+' lines)'
+        variant.model = each.model+'_u'+str(lines)
+        variant.cpu_family = ''
+        variant.cpu_model = []
+        variant.isolate = []
+        variant.widths = []
+        variant.datatypes = []
+        variant.unroll = []
+        variant.lines = lines
+        variants.append(variant)
+architectures.extend(variants)
+
 if verbose == True:
     print("source directory: "+dirname)
     print("output directory: "+outdir)
@@ -190,6 +288,7 @@ for each in templates:
 # list of files to generate besides the special assembler files from above
 # new files have to be added here. Furthermore, if the files use templates, the
 # respective modules have to be imported from the templates directory (see line 25/26)
+files.append('source_files/asm_offsets.h')
 files.append('source_files/cpu.h')
 files.append('source_files/firestarter_global.h')
 files.append('source_files/generic.c')
@@ -277,3 +376,57 @@ for file in files:
             dest.write(line)
     source.close()
     dest.close()
+
+# assembler implementations for the Linux build, the Windows build uses the inline assembler of the C files
+for each in templates:
+    if verbose == True:
+        print(" processing "+each.file+".S")
+    asm_functions_s.convert(outdir+each.file+'.c',outdir+each.file+'.S',each.file+'.c')
+
+# front end capacities used to classify the loops, Skylake: 32 KiB L1i and 1536 uops in the decoded ICache (DSB)
+l1i_size = 32768
+dsb_uops = 1536
+
+if report == True:
+    # loop size in bytes from the symbols of the loop labels in the assembled .S files, uops estimated as one (micro-fused) uop per instruction
+    cc = os.environ.get('CC','gcc')
+    print("\ncode size of the loops (bytes from "+cc+", uops estimated as one per instruction):")
+    print("{:<34} {:>6} {:>8} {:>6} {:>10}  {}".format("function","lines","bytes","uops","L1i lines","front end"))
+    for isa in templates:
+        source = outdir+isa.file+'.c'
+        obj = outdir+isa.file+'.report.o'
+        if subprocess.call([cc,'-c','-I'+outdir,'-o',obj,outdir+isa.file+'.S']) != 0:
+            print("Error: assembling "+outdir+isa.file+".S failed")
+            sys.exit(2)
+        symbols = {}
+        for line in subprocess.check_output(['nm',obj]).decode().splitlines():
+            fields = line.split()
+            if len(fields) == 3:
+                symbols[fields[2]] = int(fields[0],16)
+        os.remove(obj)
+        code = open(source).read()
+        for each in architectures:
+            for item in each.isa:
+                if item+'_functions' != isa.file:
+                    continue
+                for threads in each.threads:
+                    func_name = each.arch+'_'+each.model+'_'+item+'_'+threads+'t'
+                    start = '_work_loop_'+func_name
+                    end = '_work_done_'+func_name
+                    if start not in symbols or end not in symbols:
+                        continue
+                    size = symbols[end]-symbols[start]
+                    body = code[code.index('"'+start+':"'):code.index('"'+end+':"')]
+                    uops = 0
+                    for line in body.splitlines():
+                        for inst in ''.join(re.findall(r'"([^"]*)"',line.split('//')[0])).split(';'):
+                            inst = inst.strip()
+                            if inst and not inst.endswith(':') and not inst.startswith('.'):
+                                uops += 1
+                    if uops <= dsb_uops:
+                        frontend = "fits the uop cache"
+                    elif size <= l1i_size:
+                        frontend = "fits L1i, legacy decode"
+                    else:
+                        frontend = "exceeds L1i"
+                    print("{:<34} {:>6} {:>8} {:>6} {:>10}  {}".format(func_name,each.lines//int(threads),size,uops,(size+63)//64,frontend))
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#include "work.h"
+
+/*
+ * cache line contention payloads
+ * the threads of a group (see --coherence) share the cache lines at threaddata->addrShared,
+ * every iteration moves COH_TRANSFERS cache lines between the cores of the group:
+ * - atomic:   all members increment the same counter with locked read-modify-write operations
+ * - pingpong: the members pass a token in turn, a member waits until the token is its slot and increments it
+ * - queue:    every member produces lines into its queue and consumes the lines of the previous member
+ * waits return when the load level changes, the shared lines keep the state for the next call
+ */
+
+/*
+ * head (written by the producer), tail (written by the consumer), and data lines of the queue of a member
+ */
+#define COH_QUEUE(threaddata, slot) ((volatile unsigned long long *)((threaddata)->addrShared + (slot) * COH_QUEUE_BYTES))
+#define COH_HEAD(queue)             ((queue)[0])
+#define COH_TAIL(queue)             ((queue)[COH_LINE / sizeof(unsigned long long)])
+#define COH_DATA(queue, n)          ((queue) + (2 + (n) % COH_QUEUE_LINES) * (COH_LINE / sizeof(unsigned long long)))
+
+static int init_coh(threaddata_t* threaddata)
+{
+    threaddata->flops = 0;
+    threaddata->bytes = COH_TRANSFERS * COH_LINE;
+
+    return EXIT_SUCCESS;
+}
+
+int init_coh_atomic(threaddata_t* threaddata)
+{
+    return init_coh(threaddata);
+}
+
+int init_coh_pingpong(threaddata_t* threaddata)
+{
+    return init_coh(threaddata);
+}
+
+int init_coh_queue(threaddata_t* threaddata)
+{
+    return init_coh(threaddata);
+}
+
+/*
+ * the work functions below follow the convention of the generated ones:
+ * run threaddata->chunk iterations (0: until the load level changes) and
+ * accumulate them in threaddata->iterations
+ */
+
+/**
+ * locked increments of a counter shared by the group
+ */
+int asm_work_coh_atomic(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    volatile unsigned long long *counter = (volatile unsigned long long *)threaddata->addrShared;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned int i;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        for (i = 0; i < COH_TRANSFERS; i++) __sync_fetch_and_add(counter, 1);
+        threaddata->iterations++;
+    } while (--chunk && (*high == LOAD_HIGH));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * token passed around the group, every pass moves the line to the next member
+ */
+int asm_work_coh_pingpong(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    volatile unsigned long long *token = (volatile unsigned long long *)threaddata->addrShared;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long size = threaddata->coh_size, slot = threaddata->coh_slot;
+    unsigned int i;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        for (i = 0; i < COH_TRANSFERS; i++) {
+            while (*token % size != slot) {
+                if (*high != LOAD_HIGH) return EXIT_SUCCESS;
+                __asm__ __volatile__("pause;");
+            }
+            *token = *token + 1;
+        }
+        threaddata->iterations++;
+    } while (--chunk && (*high == LOAD_HIGH));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * producer/consumer ring: each member sends COH_TRANSFERS lines to the next one and receives as many from the previous one
+ */
+int asm_work_coh_queue(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    volatile unsigned long long *out = COH_QUEUE(threaddata, threaddata->coh_slot);
+    volatile unsigned long long *in = COH_QUEUE(threaddata, (threaddata->coh_slot + threaddata->coh_size - 1) % threaddata->coh_size);
+    volatile unsigned long long *line;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long head = COH_HEAD(out), tail = COH_TAIL(in), sum = 0;
+    unsigned int i, sent, received, progress;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        sent = received = 0;
+        while ((sent < COH_TRANSFERS) || (received < COH_TRANSFERS)) {
+            progress = 0;
+            if ((sent < COH_TRANSFERS) && (head - COH_TAIL(out) < COH_QUEUE_LINES)) {
+                line = COH_DATA(out, head);
+                for (i = 0; i < COH_LINE / sizeof(unsigned long long); i++) line[i] = head + i;
+                /* x86 keeps the order of the stores, the data is written before the head is published */
+                __asm__ __volatile__("" : : : "memory");
+                COH_HEAD(out) = ++head;
+                sent++;
+                progress = 1;
+            }
+            if ((received < COH_TRANSFERS) && (COH_HEAD(in) != tail)) {
+                line = COH_DATA(in, tail);
+                for (i = 0; i < COH_LINE / sizeof(unsigned long long); i++) sum += line[i];
+                __asm__ __volatile__("" : : : "memory");
+                COH_TAIL(in) = ++tail;
+                received++;
+                progress = 1;
+            }
+            if (!progress) {
+                if (*high != LOAD_HIGH) return EXIT_SUCCESS;
+                __asm__ __volatile__("pause;");
+            }
+        }
+        threaddata->iterations++;
+    } while (--chunk && (*high == LOAD_HIGH));
+    /* keep the sum alive, otherwise the loads are removed */
+    __asm__ __volatile__("" : : "r" (sum));
+
+    return EXIT_SUCCESS;
+}
@@ -49,6 +49,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "cpu.h"
+#include "throttle.h"
 
 #define THREAD_WAIT        1
 #define THREAD_WORK        2
@@ -66,6 +67,39 @@
 
 #define INIT_BLOCKSIZE  8192
 
+/* initial value of the registers of the integer shift operations in the payload */
+#define DEFAULT_SHIFT_SEED 0xAAAAAAAA
+
+/* phases of the experiment loop, index of the per-phase counters in threaddata_t */
+#define PHASE_PAYLOAD      0
+#define PHASE_SECONDARY    1
+#define NUM_PHASES         2
+
+/* size of the per secondary workload counters in threaddata_t, at least NUM_SECONDARY (see secondary.h) */
+#define MAX_SECONDARY      8
+
+/* maximal number of functions that --sweep runs back to back */
+#define MAX_SWEEP          8
+
+/* --pstate-sweep: maximal number of ratios, default dwell per ratio in ms, and the part of the dwell
+ * that is not measured while the frequency settles */
+#define MAX_PSTATES        64
+#define PSTATE_DWELL_MS    2000
+#define PSTATE_SETTLE      0.1
+
+/* thread_pstate of the threads whose CPU is not listed in --pstate, they use pstate of the run configuration */
+#define PSTATE_UNLISTED    (~0UL)
+
+/* phase sequence: maximal nesting of repeat blocks */
+#define PHASE_MAX_DEPTH    8
+
+/* maximal number of packages whose ENERGY_STATUS is read (--target-watts, efficiency report) */
+#define MAX_PACKAGES       16
+
+/* number of loop iterations per asm_work call (see --chunk and --chunk-us) */
+#define DEFAULT_CHUNK   500
+#define CHUNK_CALIBRATION_USEC 10000
+
 /*
  * watchdog timer
  */
@@ -75,6 +109,9 @@ typedef struct watchdog_args {
     useconds_t period;
     useconds_t load;
     unsigned int timeout;
+    double target_watts;            /* --target-watts: power that the high load share is controlled to, 0 = open loop */
+    double kp, ki, kd;              /* gains of the PID controller, the error is relative to target_watts */
+    unsigned int packages;          /* packages whose power is summed */
 } watchdog_arg_t;
 watchdog_arg_t watchdog_arg;
 
@@ -87,6 +124,27 @@ typedef struct mydata
    int *thread_comm;
    volatile unsigned int ack;   
    unsigned int num_threads;
+   unsigned long long verify_reference; /* checksum of the payload results, see verify.h */
+   char *sharedMem;                     /* cache lines of the coherence functions, COH_GROUP_BYTES per group */
+   struct powercap *powercap;           /* RAPL limit schedule (--rapl-schedule), NULL if not used */
+   unsigned char pstates[MAX_PSTATES];  /* ratios of --pstate-sweep in the order they are run */
+   unsigned int num_pstates;            /* 0 = no P-state sweep */
+   unsigned long long dwell_tsc;        /* cycles that each ratio is held */
+   volatile unsigned int pstate_current;         /* index of the ratio that runs, num_pstates = done */
+   volatile unsigned long long pstate_measure;   /* TSC from which the current ratio is measured */
+   volatile unsigned long long pstate_deadline;  /* TSC at which the next ratio starts */
+   int campaign;                        /* --campaign: the threads wait for the next run instead of exiting */
+   const char *run_dir;                 /* prefix of the output files of the threads, "" or "dir/" */
+   volatile unsigned int run_done;      /* threads that completed the current run */
+   const struct phase_seq *phases;      /* --phases, NULL = sequence built from the run configuration */
+   volatile unsigned int phase_stop;    /* a thread filled its sample buffer, the run ends at the next transition */
+   volatile unsigned long long phase_arrived; /* completions of steps by their active threads */
+   volatile unsigned long long phase_start;   /* TSC of the last transition, start of the deadline of a timed step */
+   unsigned long long phase_limit;            /* POWER_LIMIT before the caps of the steps, restored at the end */
+   volatile unsigned long long phase_samples_sum;    /* samples, ... */
+   volatile unsigned long long phase_iterations_sum; /* ... loop iterations, ... */
+   volatile unsigned long long phase_flops_sum;      /* ... floating point operations, ... */
+   volatile unsigned long long phase_bytes_sum;      /* ... and bytes of the completed steps of all threads */
 } mydata_t;
 
 typedef struct msrdata
@@ -100,9 +158,118 @@ typedef struct msrdata
 	uint64_t pmc2;
 	uint64_t pmc3;
 	uint64_t log;
+	uint64_t phase;
+	uint64_t limits;
 	double   watts;
 } msrdata_t;
 
+/* run configuration of the experiment loop, see fsconfig.h */
+typedef struct fsconfig
+{
+   unsigned long iterations;        /* samples per thread, size of msrdata */
+   double pl1_power;                /* PL1 of POWER_LIMIT in W */
+   double pl1_window;               /* PL1 time window in s */
+   double pl2_power;                /* PL2 of POWER_LIMIT in W */
+   unsigned int pl2_window;         /* PL2 time window, raw 7 bit field of POWER_LIMIT */
+   unsigned long pstate;            /* PERF_CTL target (bits 15:0) of every thread without --pstate */
+   unsigned int turbo;              /* 0 = set the turbo disengage bit of PERF_CTL */
+   unsigned int duty;               /* samples per cycle of the phases */
+   unsigned int partitions;         /* partitions of a cycle, each runs the payload or the secondary workload */
+   double maxfreq;                  /* frequency that APERF/MPERF is scaled with in GHz */
+   unsigned long payload_partitions;   /* partitions that run the payload ... */
+   unsigned long secondary_partitions; /* ... followed by partitions that run the secondary workload */
+   double partition_time;           /* duration of a partition in s, 0 = duty / partitions samples */
+} fsconfig_t;
+
+/* step of the phase sequence, see phases.h */
+typedef struct phase_step
+{
+   unsigned char type;              /* PHASE_STEP_RUN, PHASE_STEP_REPEAT, or PHASE_STEP_END */
+   unsigned char workload;          /* 0 = payload, ID of a secondary workload, or PHASE_IDLE */
+   unsigned int line;               /* line in the sequence file, 0 = built from the run configuration */
+   unsigned int count;              /* PHASE_STEP_REPEAT: repetitions (0 = forever), PHASE_STEP_END: index of the repeat */
+   unsigned long samples;           /* duration in samples of the experiment loop ... */
+   double seconds;                  /* ... or in s, both 0 = until the end of the run */
+   unsigned long pstate;            /* PERF_CTL target of the active threads, 0 = the one of each thread */
+   double cap;                      /* PL1 of the package in W, 0 = no limit */
+   char *cores;                     /* CPULIST of the active threads, NULL = all */
+   unsigned char *active;           /* per thread: 1 = runs the step, NULL = all */
+   unsigned int num_active;         /* threads that run the step */
+} phase_step_t;
+
+typedef struct phase_seq
+{
+   phase_step_t *steps;
+   unsigned int num_steps;
+   int uniform;                     /* all threads run all steps for a number of samples */
+   int pstates;                     /* a step sets a P-state */
+   int caps;                        /* a step sets a power limit */
+} phase_seq_t;
+
+/* transition of the phase sequence, logged by the first thread */
+typedef struct phase_log
+{
+   unsigned long long tsc;
+   double joules;                   /* energy of all packages since the start of the run */
+   unsigned int step;               /* entered step, num_steps = end of the run */
+   unsigned long long samples;      /* phase_samples_sum, ... */
+   unsigned long long iterations;
+   unsigned long long flops;
+   unsigned long long bytes;        /* ... and phase_bytes_sum of mydata_t */
+} phase_log_t;
+
+/* entry of the RAPL limit schedule, see powercap.h */
+typedef struct powercap_step
+{
+   double offset;                   /* time since the start of the experiment loop in s */
+   double pl1_power, pl1_window;    /* W and s, a power of 0 disables the limit */
+   double pl2_power, pl2_window;
+   unsigned long long deadline;     /* TSC at which the step is due */
+   unsigned long long applied;      /* TSC after the POWER_LIMIT write, 0 = not applied */
+   uint64_t limit;                  /* value written to POWER_LIMIT */
+} powercap_step_t;
+
+/* power sample of the control thread of the schedule */
+typedef struct powercap_sample
+{
+   unsigned long long tsc;
+   double watts;                    /* package power since the previous sample */
+   unsigned int step;               /* applied steps at the time of the sample */
+   unsigned int event;              /* 1 = taken right after a step was applied */
+} powercap_sample_t;
+
+/* RAPL limit schedule applied by a control thread during the experiment loop */
+typedef struct powercap
+{
+   powercap_step_t *steps;
+   unsigned int num_steps;
+   volatile unsigned int current;   /* number of applied steps, logged in the trace of every thread */
+   volatile int stop;
+   int started;
+   pthread_t thread;
+   unsigned int package;            /* package whose limit is controlled */
+   unsigned long long start_tsc;
+   unsigned long long clockrate;
+   double power_unit, time_unit, energy_unit;
+   uint64_t saved_limit;            /* POWER_LIMIT before the first step, restored at the end */
+   powercap_sample_t *samples;
+   unsigned long num_samples, max_samples;
+} powercap_t;
+
+/* statistics of a function of --sweep */
+typedef struct sweepdata
+{
+   unsigned long long flops;
+   unsigned long long bytes;
+   unsigned long long reset_count[MAX_CACHELEVELS];
+   unsigned long long iterations;   /* payload iterations */
+   unsigned long long tsc;          /* cycles spent in the payload */
+   unsigned long long aperf;        /* APERF and MPERF deltas of the payload calls */
+   unsigned long long mperf;
+   unsigned long long wall_tsc;     /* cycles between the switches, first thread only */
+   double joules;                   /* package energy between the switches, first thread only */
+} sweepdata_t;
+
 /* data needed by each thread */
 typedef struct threaddata
 {
@@ -112,18 +279,76 @@ typedef struct threaddata
    unsigned long long addrHigh;             
    unsigned long long buffersizeMem;
    unsigned long long iterations;
+   unsigned long long chunk;        /* loop iterations per asm_work call, 0 = until load level changes */
+   unsigned int shift_seed;         /* initial value of the shift registers of the payload */
+   unsigned long long buffersize[MAX_CACHELEVELS + 1]; /* L1, L2, L3, and RAM part of the buffer in bytes */
+   unsigned long long reset_count[MAX_CACHELEVELS];    /* loop iterations until the L2, L3, and RAM pointers are reset */
+   unsigned long long results[256]; /* vector registers at the end of the last payload call (*_functions.S), up to 32 zmm */
+   unsigned long long chunk_us;     /* target duration of one call in usec, chunk is calibrated from it */
+   unsigned long long bandwidth;    /* target bandwidth of the memory functions in MB/s, 0 = unlimited */
+   unsigned long long pace_tsc;     /* cycles per iteration that result in the target bandwidth */
    unsigned long long flops;
    unsigned long long bytes;
+   unsigned long long phase_iterations[NUM_PHASES]; /* loop iterations accumulated per phase */
+   unsigned long long phase_tsc[NUM_PHASES];        /* cycles spent in each phase */
+   unsigned long long secondary_iterations[MAX_SECONDARY]; /* loop iterations and cycles of the secondary phase, ... */
+   unsigned long long secondary_tsc[MAX_SECONDARY];        /* ... per secondary workload (--phases can run several) */
    unsigned long long start_tsc;
    unsigned long long stop_tsc;
    unsigned int alignment;      
    unsigned int cpu_id;
    unsigned int thread_id;
-   unsigned int package;
+   unsigned int package;            /* package of cpu_id, 0 if unknown */
    unsigned int period;                     
    unsigned char FUNCTION;
+   unsigned char secondary;         /* secondary workload of the alternating phases, see secondary.h */
+   unsigned char data_pattern;      /* operand data pattern of the payload, see pattern.h */
+   unsigned char sweep[MAX_SWEEP];  /* functions of --sweep, one per payload partition */
+   unsigned int num_sweep;          /* 0 = no sweep, FUNCTION is used throughout */
+   unsigned int sweep_pos;          /* index of FUNCTION in sweep */
+   sweepdata_t sweepdata[MAX_SWEEP];
+   unsigned long long sweep_energy; /* ENERGY_STATUS and TSC at the last switch, first thread only */
+   unsigned long long sweep_start;
+   sweepdata_t pstatedata[MAX_PSTATES]; /* statistics of each ratio of --pstate-sweep */
+   unsigned int pstate_pos;         /* index of the ratio written to PERF_CTL, num_pstates = none yet */
+   unsigned long pstate;            /* PERF_CTL target (bits 15:0) of this CPU, see --pstate */
+   uint64_t perf_saved;             /* PERF_CTL before the first write, restored at the end */
+   unsigned int perf_saved_valid;
+   unsigned long long pstate_energy; /* ENERGY_STATUS and TSC at the start of the measurement, first thread only */
+   unsigned long long pstate_start; /* 0 = the current ratio is not measured yet */
+   unsigned int phase_pc;           /* step of the phase sequence that runs */
+   unsigned int phase_depth;        /* open repeat blocks ... */
+   unsigned int phase_loops[PHASE_MAX_DEPTH]; /* ... and their remaining repetitions */
+   unsigned long phase_samples;     /* samples taken in the current step */
+   unsigned long long phase_deadline; /* TSC at which a timed step ends */
+   int phase_timed;                 /* the previous step was timed, the deadline of the next one starts from its deadline */
+   unsigned long long phase_work_start; /* phase_iterations at the start of the current step */
+   unsigned long long phase_arrivals; /* value of phase_arrived at the end of the current step */
+   phase_log_t *phase_log;          /* transitions, first thread only */
+   unsigned long phase_log_num, phase_log_max;
+   uint64_t phase_energy[MAX_PACKAGES]; /* ENERGY_STATUS of each package at the last transition, first thread only */
+   double phase_joules[MAX_PACKAGES][NUM_PHASES]; /* energy of each package in the steps of each phase, first thread only */
+   unsigned long long phase_wall[NUM_PHASES];     /* cycles of the steps of each phase, first thread only */
+   unsigned long long efficiency_iterations[NUM_PHASES]; /* loop iterations, ... */
+   unsigned long long efficiency_flops[NUM_PHASES];      /* ... floating point operations, ... */
+   unsigned long long efficiency_bytes[NUM_PHASES];      /* ... and bytes of the completed steps of each phase */
+   throttle_t throttle;             /* limit reasons of the samples */
+   char *secondaryMem;
+   unsigned long long secondaryPos;
+   unsigned long long verify_tsc;   /* cycles between two verifications of the payload results, 0 = off */
+   unsigned long long verify_next;  /* TSC of the next verification */
+   unsigned long long verify_cycles;
+   unsigned long long verify_checks;
+   unsigned long long verify_errors;
+   char *verifyMem;                 /* private buffer of the verification runs */
+   unsigned char verify_function;
+   unsigned long long addrShared;   /* area of the group in sharedMem, coherence functions only */
+   unsigned int coh_slot;           /* position in the group */
+   unsigned int coh_size;           /* number of threads in the group */
    unsigned long iter;
    msrdata_t *msrdata;
+   unsigned long msrdata_size;      /* allocated samples, the buffer is reused by the runs of a campaign */
+   const fsconfig_t *config;        /* run configuration, parsed once in main() */
    unsigned numthreads;
    volatile char *barrierdata;
 } threaddata_t;
@@ -30,10 +30,17 @@ int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata) __attribute__((noinli
 int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
+    unsigned int shift_seed = threaddata->shift_seed;
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -49,6 +56,7 @@ int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata)
          *   - r14:         stores cacheline width as increment for buffer addresses
          *   - r15:         stores address of shared variable that controls load level
          *   - mm0:         stores iteration counter
+         *   - mm1:         stores number of iterations left in this call
          *   - rdi,rsi,rdx: registers for shift operations
          *   - xmm*,ymm*:   data registers for SIMD instructions
          */
@@ -56,11 +64,12 @@ int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata)
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r15;" // store address of shared variable that controls load level in r15
         "movq %%rcx, %%mm0;" // store iteration counter in mm0
+        "movq %%rdx, %%mm1;" // store number of iterations for this call in mm1
         "mov $64, %%r14;" // increment after each cache/memory access
         //Initialize registers for shift operations
-        "mov $0xAAAAAAAA, %%edi;"
-        "mov $0xAAAAAAAA, %%esi;"
-        "mov $0xAAAAAAAA, %%edx;"
+        "mov %5, %%edi;"
+        "mov %5, %%esi;"
+        "mov %5, %%edx;"
         //Initialize AVX-Registers for FMA Operations
         "vmovapd (%%rax), %%ymm0;"
         "vmovapd (%%rax), %%ymm1;"
@@ -78,14 +87,14 @@ int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata)
         "vmovapd 672(%%rax), %%ymm13;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%r8;"
-        "add $1048576, %%r8;" // address for L3-buffer
+        "add %[l2_size], %%r8;" // address for L3-buffer
         "mov %%rax, %%r9;"
-        "add $786432, %%r9;" // address for RAM-buffer
-        "movabs $262, %%r10;" // reset-counter for L2-buffer with 50 cache lines accessed per loop (818.75 KB)
-        "movabs $983, %%r11;" // reset-counter for L3-buffer with 10 cache lines accessed per loop (614.38 KB)
-        "movabs $163840, %%r12;" // reset-counter for RAM-buffer with 10 cache lines accessed per loop (102400.0 KB)
+        "add %[l3_size], %%r9;" // address for RAM-buffer
+        "mov %[l2_count], %%r10;" // reset-counter for L2-buffer with 50 cache lines accessed per loop
+        "mov %[l3_count], %%r11;" // reset-counter for L3-buffer with 10 cache lines accessed per loop
+        "mov %[ram_count], %%r12;" // reset-counter for RAM-buffer with 10 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_bld_opteron_fma4_1t:"
@@ -1515,33 +1524,39 @@ int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r12;"
         "jnz _work_no_ram_reset_bld_opteron_fma4_1t;"
-        "movabs $163840, %%r12;"
+        "mov %[ram_count], %%r12;"
         "mov %%rax, %%r9;"
-        "add $786432, %%r9;"
+        "add %[l3_size], %%r9;"
         "_work_no_ram_reset_bld_opteron_fma4_1t:"
         "inc %%r13;" // increment iteration counter
         //reset L2-Cache counter
         "sub $1, %%r10;"
         "jnz _work_no_L2_reset_bld_opteron_fma4_1t;"
-        "movabs $262, %%r10;"
+        "mov %[l2_count], %%r10;"
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;"
+        "add %[l1_size], %%rcx;"
         "_work_no_L2_reset_bld_opteron_fma4_1t:"
         "movq %%r13, %%mm0;" // store iteration counter
         //reset L3-Cache counter
         "sub $1, %%r11;"
         "jnz _work_no_L3_reset_bld_opteron_fma4_1t;"
-        "movabs $983, %%r11;"
+        "mov %[l3_count], %%r11;"
         "mov %%rax, %%r8;"
-        "add $1048576, %%r8;"
+        "add %[l2_size], %%r8;"
         "_work_no_L3_reset_bld_opteron_fma4_1t:"
         "mov %%rax, %%rbx;"
+        "movq %%mm1, %%r13;" // decrement number of iterations left in this call
+        "sub $1, %%r13;"
+        "movq %%r13, %%mm1;"
+        "jz _work_done_bld_opteron_fma4_1t;"
         "testq $1, (%%r15);"
         "jnz _work_loop_bld_opteron_fma4_1t;"
+        "_work_done_bld_opteron_fma4_1t:"
         "movq %%mm0, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%rdi", "%rsi", "%rdx", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations), "m" (shift_seed),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%rdi", "%rsi", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,297 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <errno.h>
+#include "fsconfig.h"
+
+/*
+ * types of the values
+ */
+#define CFG_ULONG  0
+#define CFG_UINT   1
+#define CFG_HEX    2 /* unsigned long, printed in hex */
+#define CFG_DOUBLE 3
+#define CFG_BOOL   4 /* on/off, yes/no, t/f, or 1/0 */
+
+/*
+ * units that a value may carry and their factor to the unit of the field, the first one is printed
+ */
+typedef struct unit {
+    const char *name;
+    double factor;
+} unit_t;
+
+static const unit_t no_units[] = {{NULL, 0.0}};
+static const unit_t watts[] = {{"W", 1.0}, {"mW", 0.001}, {NULL, 0.0}};
+static const unit_t seconds[] = {{"s", 1.0}, {"ms", 0.001}, {"us", 0.000001}, {NULL, 0.0}};
+static const unit_t gigahertz[] = {{"GHz", 1.0}, {"MHz", 0.001}, {NULL, 0.0}};
+
+static const struct {
+    const char *key;
+    int type;
+    size_t offset;
+    double min;
+    double max;
+    const unit_t *units;
+} keys[] = {
+    {"iterations",           CFG_ULONG,  offsetof(fsconfig_t, iterations),           1,     100000000, no_units},
+    {"pl1_power",            CFG_DOUBLE, offsetof(fsconfig_t, pl1_power),            1,     4095,      watts},
+    {"pl1_window",           CFG_DOUBLE, offsetof(fsconfig_t, pl1_window),           0.001, 40,        seconds},
+    {"pl2_power",            CFG_DOUBLE, offsetof(fsconfig_t, pl2_power),            1,     4095,      watts},
+    {"pl2_window",           CFG_UINT,   offsetof(fsconfig_t, pl2_window),           0,     127,       no_units},
+    {"pstate",               CFG_HEX,    offsetof(fsconfig_t, pstate),               0,     0xFFFF,    no_units},
+    {"turbo",                CFG_BOOL,   offsetof(fsconfig_t, turbo),                0,     1,         no_units},
+    {"duty",                 CFG_UINT,   offsetof(fsconfig_t, duty),                 8,     100000000, no_units},
+    {"partitions",           CFG_UINT,   offsetof(fsconfig_t, partitions),           1,     1000000,   no_units},
+    {"maxfreq",              CFG_DOUBLE, offsetof(fsconfig_t, maxfreq),              0.1,   10,        gigahertz},
+    {"payload_partitions",   CFG_ULONG,  offsetof(fsconfig_t, payload_partitions),   0,     1000000,   no_units},
+    {"secondary_partitions", CFG_ULONG,  offsetof(fsconfig_t, secondary_partitions), 0,     1000000,   no_units},
+    {"partition_time",       CFG_DOUBLE, offsetof(fsconfig_t, partition_time),       0,     3600,      seconds},
+};
+#define NUM_KEYS (sizeof(keys) / sizeof(keys[0]))
+
+void fsconfig_defaults(fsconfig_t *config)
+{
+    config->iterations = 80000;
+    config->pl1_power = 90.0;
+    config->pl1_window = 1.0;
+    config->pl2_power = 120.0;
+    config->pl2_window = 50;
+    config->pstate = 0x2D00;
+    config->turbo = 1;
+    config->duty = 8800;
+    config->partitions = 4;
+    config->maxfreq = 4.2;
+    config->payload_partitions = 0;
+    config->secondary_partitions = 0;
+    config->partition_time = 0.0;
+}
+
+/*
+ * removes leading and trailing white space in place
+ */
+static char *trim(char *str)
+{
+    char *end;
+
+    while (isspace((unsigned char)*str)) str++;
+    end = str + strlen(str);
+    while ((end > str) && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+
+    return str;
+}
+
+/*
+ * parses value for keys[k] into config, where names the origin in error messages,
+ * returns EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int parse_value(fsconfig_t *config, unsigned int k, const char *value, const char *where)
+{
+    char *field = (char *)config + keys[k].offset;
+    char *end;
+    const unit_t *unit;
+    double val;
+
+    if (keys[k].type == CFG_BOOL) {
+        if (!strcasecmp(value, "on") || !strcasecmp(value, "yes") || !strcasecmp(value, "t") || !strcmp(value, "1")) {
+            *(unsigned int *)field = 1;
+        }
+        else if (!strcasecmp(value, "off") || !strcasecmp(value, "no") || !strcasecmp(value, "f") || !strcmp(value, "0")) {
+            *(unsigned int *)field = 0;
+        }
+        else {
+            fprintf(stderr, "Error: %s: %s has to be on or off, not %s\n", where, keys[k].key, value);
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    errno = 0;
+    if (keys[k].type == CFG_DOUBLE) val = strtod(value, &end);
+    else val = (value[0] == '-') ? -1.0 : (double)strtoul(value, &end, 0);
+    if ((val < 0.0) || (end == value) || errno) {
+        fprintf(stderr, "Error: %s: %s: invalid number: %s\n", where, keys[k].key, value);
+        return EXIT_FAILURE;
+    }
+    while (isspace((unsigned char)*end)) end++;
+    if (*end != '\0') {
+        for (unit = keys[k].units; unit->name != NULL; unit++) {
+            if (strcmp(end, unit->name) == 0) break;
+        }
+        if (unit->name == NULL) {
+            fprintf(stderr, "Error: %s: %s: unknown unit: %s\n", where, keys[k].key, end);
+            return EXIT_FAILURE;
+        }
+        val *= unit->factor;
+    }
+    if ((val < keys[k].min) || (val > keys[k].max)) {
+        fprintf(stderr, "Error: %s: %s = %s is out of range [%g, %g]%s%s\n", where, keys[k].key, value,
+                keys[k].min, keys[k].max, keys[k].units->name ? " " : "", keys[k].units->name ? keys[k].units->name : "");
+        return EXIT_FAILURE;
+    }
+
+    switch (keys[k].type) {
+      case CFG_ULONG:
+      case CFG_HEX:
+        *(unsigned long *)field = (unsigned long)val;
+        break;
+      case CFG_UINT:
+        *(unsigned int *)field = (unsigned int)val;
+        break;
+      default:
+        *(double *)field = val;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * parses "key = value" (= or white space separated), returns the index of the key or -1
+ */
+static int parse_assignment(fsconfig_t *config, char *line, const char *where)
+{
+    char *key = line, *value;
+    unsigned int k;
+
+    value = strchr(line, '=');
+    if (value == NULL) {
+        fprintf(stderr, "Error: %s: expected key = value, not: %s\n", where, line);
+        return -1;
+    }
+    *value++ = '\0';
+    key = trim(key);
+    value = trim(value);
+    for (k = 0; k < NUM_KEYS; k++) {
+        if (strcmp(key, keys[k].key) == 0) break;
+    }
+    if (k == NUM_KEYS) {
+        fprintf(stderr, "Error: %s: unknown key: %s\n", where, key);
+        return -1;
+    }
+    if (parse_value(config, k, value, where) != EXIT_SUCCESS) return -1;
+
+    return (int)k;
+}
+
+int fsconfig_read(fsconfig_t *config, const char *file, int required)
+{
+    FILE *stream = fopen(file, "r");
+    char line[256], where[300], *start, *comment;
+    unsigned int lineno = 0, seen[NUM_KEYS];
+    int k;
+
+    if (stream == NULL) {
+        if (required) {
+            fprintf(stderr, "Error: cannot open the configuration file %s\n", file);
+            return EXIT_FAILURE;
+        }
+        fprintf(stderr, "Warning: no configuration file %s, using the defaults\n", file);
+        return EXIT_SUCCESS;
+    }
+
+    memset(seen, 0, sizeof(seen));
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        lineno++;
+        comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        start = trim(line);
+        if (*start == '\0') continue;
+        snprintf(where, sizeof(where), "%s:%u", file, lineno);
+        if (strchr(start, '=') == NULL) {
+            fprintf(stderr, "Error: %s: expected key = value, not: %s (the positional format is no longer supported, see README)\n", where, start);
+            fclose(stream);
+            return EXIT_FAILURE;
+        }
+        k = parse_assignment(config, start, where);
+        if (k < 0) {
+            fclose(stream);
+            return EXIT_FAILURE;
+        }
+        if (seen[k]) {
+            fprintf(stderr, "Error: %s: %s is set twice, first in line %u\n", where, keys[k].key, seen[k]);
+            fclose(stream);
+            return EXIT_FAILURE;
+        }
+        seen[k] = lineno;
+    }
+    fclose(stream);
+
+    return EXIT_SUCCESS;
+}
+
+int fsconfig_set(fsconfig_t *config, const char *assignment, const char *where)
+{
+    char line[256];
+
+    snprintf(line, sizeof(line), "%s", assignment);
+    return (parse_assignment(config, line, where) < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int fsconfig_validate(const fsconfig_t *config)
+{
+    if (config->duty < config->partitions) {
+        fprintf(stderr, "Error: configuration: duty (%u) has to be at least the number of partitions (%u)\n", config->duty, config->partitions);
+        return EXIT_FAILURE;
+    }
+    if (config->pl2_power < config->pl1_power) {
+        fprintf(stderr, "Warning: configuration: pl2_power (%g W) is below pl1_power (%g W)\n", config->pl2_power, config->pl1_power);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void fsconfig_print(FILE *stream, const fsconfig_t *config)
+{
+    const char *field;
+    unsigned int k;
+
+    for (k = 0; k < NUM_KEYS; k++) {
+        field = (const char *)config + keys[k].offset;
+        fprintf(stream, "%s = ", keys[k].key);
+        switch (keys[k].type) {
+          case CFG_ULONG:
+            fprintf(stream, "%lu", *(const unsigned long *)field);
+            break;
+          case CFG_HEX:
+            fprintf(stream, "0x%lx", *(const unsigned long *)field);
+            break;
+          case CFG_UINT:
+            fprintf(stream, "%u", *(const unsigned int *)field);
+            break;
+          case CFG_BOOL:
+            fprintf(stream, "%s", *(const unsigned int *)field ? "on" : "off");
+            break;
+          default:
+            fprintf(stream, "%g", *(const double *)field);
+        }
+        if (keys[k].units->name) fprintf(stream, " %s", keys[k].units->name);
+        fprintf(stream, "\n");
+    }
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__FSCONFIG_H
+#define __FIRESTARTER__FSCONFIG_H
+
+#include <stdio.h>
+#include "firestarter_global.h"
+
+/*
+ * run configuration of the experiment loop: one "key = value" per line, # starts a comment,
+ * values may carry a unit (W, s, ms, us, GHz, MHz), see fsconfig.c for the keys, defaults, and ranges
+ */
+#define FSCONFIG_FILE          "fsconfig"
+
+/*
+ * maximal number of --set overrides
+ */
+#define MAX_FSCONFIG_SETS      64
+
+/*
+ * sets the defaults
+ */
+extern void fsconfig_defaults(fsconfig_t *config);
+
+/*
+ * reads the keys in file, a missing file is an error only if required is set,
+ * returns EXIT_SUCCESS or EXIT_FAILURE after printing the reason
+ */
+extern int fsconfig_read(fsconfig_t *config, const char *file, int required);
+
+/*
+ * applies one "key=value" (--set, --campaign), where is the origin shown in the error messages,
+ * returns EXIT_SUCCESS or EXIT_FAILURE after printing the reason
+ */
+extern int fsconfig_set(fsconfig_t *config, const char *assignment, const char *where);
+
+/*
+ * checks the ranges and the dependencies of the values, returns EXIT_SUCCESS or EXIT_FAILURE after printing the reason
+ */
+extern int fsconfig_validate(const fsconfig_t *config);
+
+/*
+ * prints all keys with their values in the format of the file
+ */
+extern void fsconfig_print(FILE *stream, const fsconfig_t *config);
+
+#endif
+
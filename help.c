@@ -43,8 +43,16 @@ void show_help(void)
            " -q         | --quiet            disable output to stdout\n"
            " -r         | --report           display additional information (overridden by -q)\n"
            " -a         | --avail            list available functions\n"
-           " -i ID      | --function=ID      specify integer ID of the load-function to be\n"
-           "                                 used (as listed by --avail)\n"
+           " -i ID      | --function=ID      specify integer ID or name of the load-function\n"
+           "                                 to be used (as listed by --avail)\n"
+           " -i MAP     | --function=MAP     per CPU functions, MAP format: \"CPULIST:ID\",\n"
+           "                                 e.g. \"0-15:2,16-31:skl_corei_fma_2t\", CPUs\n"
+           "                                 that are not listed use the default function\n"
+           "            | --auto-function[=MS]\n"
+           "                                 run every usable function for MS (default 500)\n"
+           "                                 ms and continue with the one with the highest\n"
+           "                                 package power (IPC without RAPL), the ranking is\n"
+           "                                 cached per CPUID signature in ./fsauto\n"
            " -f         | --usegpufloat      use single precision matrix multiplications instead of double\n"
            " -g         | --gpus             number of gpus to use (default: all)\n"
            " -m         | --matrixsize       size of the matrix to calculate (default: 12288)\n"
@@ -61,6 +69,76 @@ void show_help(void)
            " -n COUNT   | --threads=COUNT    specify the number of threads\n"
            "                                 cannot be combined with -b | --bind, which\n"
            "                                 implicitly specifies the number of threads\n"
+           "            | --chunk=COUNT      number of payload loop iterations per sample,\n"
+           "                                 default: 500, 0 runs until the load level changes\n"
+           "            | --chunk-us=USEC    target duration of one sample (usec), the\n"
+           "                                 number of iterations is calibrated at startup\n"
+           "            | --secondary=NAME   workload of the alternating phases, default: int\n"
+           "                                 int, ptrchase, stream, sse, pause, or sleep\n"
+           "            | --bandwidth=MBPS   target bandwidth per thread (MB/s) of the memory\n"
+           "                                 functions (IDs 17-20), default: unlimited\n"
+           "            | --sweep[=KIND]     run variants of the function back to back, one\n"
+           "                                 per payload phase, KIND: levels (L1, L2, L3,\n"
+           "                                 RAM, and REG only, default), widths (128,\n"
+           "                                 256, and 512 bit SIMD),\n"
+           "                                 or unroll (loops of 288 to 1536 lines, reports\n"
+           "                                 the smallest one with the full FLOPS rate)\n"
+           "            | --data-pattern=NAME\n"
+           "                                 operand data of the payload buffer and\n"
+           "                                 registers: zeros, ones (all mantissa bits),\n"
+           "                                 alternate (0xAA/0x55), random, or toggle\n"
+           "                                 (complement every 32 bytes), default: the\n"
+           "                                 ramp written by the init functions\n"
+           "            | --coherence=PLACEMENT[/SIZE]\n"
+           "                                 groups of SIZE (default 2) threads that share\n"
+           "                                 cache lines in the functions 49-51 (atomic,\n"
+           "                                 pingpong, queue), PLACEMENT: core (SMT\n"
+           "                                 siblings), package (default), or system\n"
+           "                                 (different packages)\n"
+           "            | --config=FILE      run configuration of the experiment loop, one\n"
+           "                                 \"key = value\" per line (default: ./fsconfig,\n"
+           "                                 the defaults are used if it does not exist)\n"
+           "            | --set=KEY=VALUE    override one key of the run configuration, can\n"
+           "                                 be repeated\n"
+           "            | --rapl-schedule=FILE\n"
+           "                                 apply the RAPL power limits in FILE at their\n"
+           "                                 times during the experiment loop, one step per\n"
+           "                                 line: TIME PL1_W PL1_WINDOW PL2_W PL2_WINDOW\n"
+           "                                 (s, W, s, W, s), the measured power is traced\n"
+           "                                 next to the limits in powercap.trace\n"
+           "            | --pstate-sweep=RATIOS\n"
+           "                                 run the experiment loop at each P-state ratio\n"
+           "                                 of RATIOS in turn (\"x,y,z\", \"x-y\", \"x-y/step\",\n"
+           "                                 x > y runs downwards) and write the curve of\n"
+           "                                 frequency, power, and performance to\n"
+           "                                 pstate.curve\n"
+           "            | --dwell=MS         time per ratio of --pstate-sweep (default 2000),\n"
+           "                                 the first 10%% are not measured\n"
+           "            | --target-watts=W[/KP,KI,KD]\n"
+           "                                 hold the package power at W by adjusting the\n"
+           "                                 share of high load in every period (-p) with a\n"
+           "                                 PID controller (default gains 0.5,2,0), -l sets\n"
+           "                                 the initial share, the setpoint, power, and\n"
+           "                                 share are traced in powertarget.trace\n"
+           "            | --pstate=CPULIST:VALUE[,CPULIST:VALUE...]\n"
+           "                                 PERF_CTL target (bits 15:0, e.g. 0x2D00) of the\n"
+           "                                 threads on the listed CPUs, the others use\n"
+           "                                 pstate of the run configuration, every thread\n"
+           "                                 restores its PERF_CTL at the end\n"
+           "            | --campaign=FILE    execute the runs in FILE back to back with the\n"
+           "                                 same threads and buffers, one per line: NAME\n"
+           "                                 KEY=VALUE ..., the keys override the run\n"
+           "                                 configuration, the output of each run and a\n"
+           "                                 manifest are written to the directory NAME\n"
+           "            | --phases=FILE      run the sequence of steps in FILE instead of the\n"
+           "                                 payload and secondary partitions, one per line:\n"
+           "                                 WORKLOAD DURATION [pstate=V] [cap=W]\n"
+           "                                 [cores=CPULIST], blocks: repeat [N] ... end,\n"
+           "                                 the transitions are written to phases.trace\n"
+           "            | --verify[=MS]      every MS (default 1000) ms, run the payload on a\n"
+           "                                 private buffer and compare the result with the\n"
+           "                                 one of the first CPU, mismatches are reported\n"
+           "                                 with the CPU and set a non-zero exit code\n"
 #if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
            " -b CPULIST | --bind=CPULIST     select certain CPUs\n"
            "                                 CPULIST format: \"x,y,z\", \"x-y\", \"x-y/step\",\n"
@@ -21,18 +21,35 @@
 
 #include "work.h"
 
+/*
+ * loop iterations until the pointer of a buffer level is reset: the covered part of the level divided by
+ * the cache lines that one loop iteration accesses in it, at least 1, 0 if the level is not accessed
+ */
+unsigned long long buffer_reset_count(unsigned long long size, double cover, unsigned int lines)
+{
+    unsigned long long count;
+
+    if (lines == 0) return 0;
+    count = (unsigned long long)(cover * size) / 64 / lines;
+    return count ? count : 1;
+}
+
 int init_nhm_corei_sse2_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_nhm_corei_sse2_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 106725376 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 106725376-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=3066;
     threaddata->bytes=1344;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 21);
 
     return EXIT_SUCCESS;
 }
@@ -40,14 +57,18 @@ int init_nhm_corei_sse2_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_nhm_corei_sse2_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 53362688 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53362688-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=1460;
     threaddata->bytes=640;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 10);
 
     return EXIT_SUCCESS;
 }
@@ -55,14 +76,18 @@ int init_nhm_xeonep_sse2_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_nhm_xeonep_sse2_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 107249664 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 107249664-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=3024;
     threaddata->bytes=1536;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 24);
 
     return EXIT_SUCCESS;
 }
@@ -70,14 +95,18 @@ int init_nhm_xeonep_sse2_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_nhm_xeonep_sse2_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 53624832 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53624832-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=1512;
     threaddata->bytes=768;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 12);
 
     return EXIT_SUCCESS;
 }
@@ -86,14 +115,18 @@ int init_snb_corei_avx_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_snb_corei_avx_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 106725376 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 106725376-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=6040;
     threaddata->bytes=1280;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 100);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 40);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 20);
 
     return EXIT_SUCCESS;
 }
@@ -101,14 +134,18 @@ int init_snb_corei_avx_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_snb_corei_avx_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 53362688 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53362688-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=3020;
     threaddata->bytes=640;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 50);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 20);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 10);
 
     return EXIT_SUCCESS;
 }
@@ -116,14 +153,18 @@ int init_snb_xeonep_avx_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_snb_xeonep_avx_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 107773952 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 107773952-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=5940;
     threaddata->bytes=2112;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 110);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 22);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 33);
 
     return EXIT_SUCCESS;
 }
@@ -131,14 +172,18 @@ int init_snb_xeonep_avx_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_snb_xeonep_avx_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-10;
-    for (i = INIT_BLOCKSIZE; i <= 53886976 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53886976-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = i * 1.654738925401e-15;
 
     threaddata->flops=2700;
     threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 50);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 10);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
 
     return EXIT_SUCCESS;
 }
@@ -147,14 +192,18 @@ int init_skl_corei_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_skl_corei_fma_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 106725376 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 106725376-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=21200;
     threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
 
     return EXIT_SUCCESS;
 }
@@ -162,14 +211,18 @@ int init_skl_corei_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_skl_corei_fma_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 53362688 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53362688-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=10600;
     threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
 
     return EXIT_SUCCESS;
 }
@@ -177,14 +230,18 @@ int init_hsw_corei_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_hsw_corei_fma_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 106725376 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 106725376-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=14880;
     threaddata->bytes=1280;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 30);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 20);
 
     return EXIT_SUCCESS;
 }
@@ -192,14 +249,18 @@ int init_hsw_corei_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_hsw_corei_fma_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 53362688 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53362688-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=7440;
     threaddata->bytes=640;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 45);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 15);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 10);
 
     return EXIT_SUCCESS;
 }
@@ -207,14 +268,18 @@ int init_hsw_xeonep_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_hsw_xeonep_fma_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 107773952 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 107773952-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=15648;
     threaddata->bytes=1536;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 108);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 12);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 24);
 
     return EXIT_SUCCESS;
 }
@@ -222,14 +287,550 @@ int init_hsw_xeonep_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
 int init_hsw_xeonep_fma_2t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 53886976 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 53886976-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=7824;
     threaddata->bytes=768;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 54);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 6);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 12);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_l1_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l1_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=24576;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_l1_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l1_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=12288;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_l2_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l2_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=24576;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 1536);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_l2_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l2_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=12288;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 768);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_l3_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l3_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=24576;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 1536);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_l3_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l3_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=12288;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 768);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_ram_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_ram_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=24576;
+    threaddata->bytes=98304;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 1536);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_ram_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_ram_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=12288;
+    threaddata->bytes=49152;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 768);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_reg_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_reg_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=24576;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_reg_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_reg_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=12288;
+    threaddata->bytes=0;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 0);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 0);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_w128_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w128_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=10600;
+    threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_w128_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w128_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=5300;
+    threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_w512_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w512_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=42400;
+    threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_w512_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w512_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=21200;
+    threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_sp_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_sp_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-4; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+
+    threaddata->flops=42400;
+    threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_sp_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_sp_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-4; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+
+    threaddata->flops=21200;
+    threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_int16_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int16_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=63600;
+    threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_int16_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int16_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=31800;
+    threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_int8_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int8_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=169600;
+    threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_int8_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int8_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=84800;
+    threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_bf16_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_bf16_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-4; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+
+    threaddata->flops=84800;
+    threaddata->bytes=1920;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 180);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 50);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 30);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_bf16_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_bf16_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-4; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;
+
+    threaddata->flops=42400;
+    threaddata->bytes=960;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 90);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 25);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 15);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_u288_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u288_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=4240;
+    threaddata->bytes=384;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 36);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 10);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 6);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_u288_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u288_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=2120;
+    threaddata->bytes=192;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 18);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 5);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 3);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_u576_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u576_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=8480;
+    threaddata->bytes=768;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 72);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 20);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 12);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_u576_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u576_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=4240;
+    threaddata->bytes=384;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 36);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 10);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 6);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_u1152_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u1152_fma_1t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=16960;
+    threaddata->bytes=1536;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 144);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 40);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 24);
+
+    return EXIT_SUCCESS;
+}
+int init_skl_corei_u1152_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u1152_fma_2t(threaddata_t* threaddata)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
+
+    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+
+    threaddata->flops=8480;
+    threaddata->bytes=768;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 72);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 20);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 12);
 
     return EXIT_SUCCESS;
 }
@@ -238,14 +839,18 @@ int init_bld_opteron_fma4_1t(threaddata_t* threaddata) __attribute__((noinline))
 int init_bld_opteron_fma4_1t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 106708992 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 106708992-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=14760;
     threaddata->bytes=640;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 50);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 10);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 10);
 
     return EXIT_SUCCESS;
 }
@@ -254,14 +859,18 @@ int init_knl_xeonphi_avx512_4t(threaddata_t* threaddata) __attribute__((noinline
 int init_knl_xeonphi_avx512_4t(threaddata_t* threaddata)
 {
     unsigned long long addrMem = threaddata->addrMem;
-    int i;
+    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];
+    unsigned long long i;
 
     for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
-    for (i = INIT_BLOCKSIZE; i <= 65762645 - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
-    for (; i <= 65762645-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
+    for (i = INIT_BLOCKSIZE; i <= buffersize - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);
+    for (; i <= buffersize-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;
 
     threaddata->flops=10656;
     threaddata->bytes=1152;
+    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], 0.8, 48);
+    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], 0.8, 0);
+    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], 1.0, 18);
 
     return EXIT_SUCCESS;
 }
@@ -34,6 +34,8 @@
 #include <pthread.h>
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
+#include <strings.h>
 #include <sys/time.h>
 #include "firestarter_global.h"
 #include "watchdog.h"
@@ -45,23 +47,31 @@
  */
 #include "work.h"
 #include "cpu.h"
+#include "secondary.h"
+#include "pattern.h"
+#include "autofunc.h"
+#include "verify.h"
+#include "fsconfig.h"
+#include "powercap.h"
+#include "campaign.h"
+#include "phases.h"
 #ifdef CUDA
 #include "gpu.h"
 #endif
 
 /*
- * used for --bind option
+ * used for the CPU lists of --bind and --function, option is the name used in error messages
  */
-#define ADD_CPU_SET(cpu,cpuset) \
+#define ADD_CPU_SET(cpu,cpuset,option) \
 do { \
   if (cpu_allowed(cpu)) { \
     CPU_SET(cpu, &cpuset); \
   } else { \
     if (cpu >= num_cpus() ) { \
-      fprintf( stderr, "Error: The given bind argument (-b/--bind) includes CPU %d that is not available on this system.\n",cpu ); \
+      fprintf( stderr, "Error: The given argument of %s includes CPU %d that is not available on this system.\n",option,cpu ); \
     } \
     else { \
-      fprintf( stderr, "Error: The given bind argument (-b/--bind) cannot be implemented with the cpuset given from the OS\n" ); \
+      fprintf( stderr, "Error: The given argument of %s cannot be implemented with the cpuset given from the OS\n",option ); \
       fprintf( stderr, "This can be caused by the taskset tool, cgroups, the batch system, or similar mechanisms.\n" ); \
       fprintf( stderr, "Please fix the argument to match the restrictions.\n" ); \
     } \
@@ -82,17 +92,235 @@ unsigned long long BUFFERSIZEMEM, RAMBUFFERSIZE;
 unsigned int BUFFERSIZE[3];
 unsigned int NUM_THREADS = 0;
 int FUNCTION = FUNC_NOT_DEFINED;
+int SECONDARY = SEC_INT;
+int DATA_PATTERN = PATTERN_DEFAULT;
+
+/*
+ * trial duration of --auto-function in ms, 0 = select FUNCTION by family and model
+ */
+unsigned int AUTO_FUNCTION = 0;
+
+/*
+ * time between two verifications of the payload results in ms, 0 = no verification
+ */
+unsigned int VERIFY = 0;
+
+/*
+ * placement and size of the thread groups that share cache lines in the coherence functions (--coherence)
+ */
+#define COH_CORE    0
+#define COH_PACKAGE 1
+#define COH_SYSTEM  2
+static const char *coherence_placements[] = {"core", "package", "system"};
+int COHERENCE = COH_PACKAGE;
+unsigned int COHERENCE_SIZE = 2;
+
+/*
+ * run configuration of the experiment loop, read from --config (default FSCONFIG_FILE) and
+ * overridden by --set KEY=VALUE, shared read-only by all threads
+ */
+fsconfig_t FSCONFIG;
+char *fsconfig_file = NULL;
+char *fsconfig_sets[MAX_FSCONFIG_SETS];
+unsigned int fsconfig_num_sets = 0;
+
+/*
+ * RAPL limit schedule that a control thread applies during the experiment loop (--rapl-schedule=FILE)
+ */
+powercap_t POWERCAP;
+char *fspowercap = NULL;
+
+/*
+ * runs that are executed back to back by the same threads, each with its own configuration and
+ * output directory (--campaign=FILE)
+ */
+campaign_t CAMPAIGN;
+char *fscampaign = NULL;
+
+/*
+ * sequence of workloads, durations, P-states, power limits, and active CPUs that replaces the payload and
+ * secondary partitions of the run configuration (--phases=FILE)
+ */
+phase_seq_t PHASES;
+char *fsphases = NULL;
+
+/*
+ * P-state ratios that the experiment loop runs one after the other for DWELL ms each (--pstate-sweep, --dwell),
+ * the curve of frequency, power, and performance is written to PSTATE_CURVE
+ */
+#define PSTATE_CURVE "pstate.curve"
+unsigned char PSTATES[MAX_PSTATES];
+unsigned int NUM_PSTATES = 0;
+unsigned int DWELL = PSTATE_DWELL_MS;
+
+/*
+ * package power that the watchdog holds by adjusting the share of high load in each period (--target-watts), 0 = off
+ */
+double TARGET_WATTS = 0.0;
+double TARGET_GAINS[3] = {TARGET_KP, TARGET_KI, TARGET_KD};
 
 /*
  * timeout and load characteristics as defind by -t, -p, and -l
  */
 long TIMEOUT = 0, PERIOD = 100000, LOAD = 100;
 
+/*
+ * number of loop iterations per asm_work call as defined by --chunk or --chunk-us
+ */
+unsigned long long CHUNK = DEFAULT_CHUNK, CHUNK_US = 0;
+
+/*
+ * target bandwidth per thread of the memory functions in MB/s as defined by --bandwidth
+ */
+unsigned long long BANDWIDTH = 0;
+
+/*
+ * variants of FUNCTION that run back to back as defined by --sweep, 0 = no sweep
+ */
+#define SWEEP_LEVELS 1
+#define SWEEP_WIDTHS 2
+#define SWEEP_UNROLL 3
+#define SWEEP_UNROLL_SATURATION 0.99 /* fraction of the highest FLOPS rate that counts as saturated */
+int SWEEP = 0;
+
+/*
+ * cache-level-isolated, SIMD width, and unroll variants of the functions (see isolate, widths, and unroll in config.cfg),
+ * unroll variants are listed from the smallest to the largest loop
+ */
+static const struct {
+    int sweep;
+    int function;
+    int variant;
+    const char *label;
+    const char *feature;
+} sweep_functions[] = {
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_L1_FMA_1T,   "L1 only",  "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_L2_FMA_1T,   "L2 only",  "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_L3_FMA_1T,   "L3 only",  "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_RAM_FMA_1T,  "RAM only", "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_REG_FMA_1T,  "REG only", "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_L1_FMA_2T,   "L1 only",  "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_L2_FMA_2T,   "L2 only",  "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_L3_FMA_2T,   "L3 only",  "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_RAM_FMA_2T,  "RAM only", "FMA"},
+    {SWEEP_LEVELS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_REG_FMA_2T,  "REG only", "FMA"},
+    {SWEEP_WIDTHS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_W128_FMA_1T, "128 bit",  "FMA"},
+    {SWEEP_WIDTHS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_FMA_1T,      "256 bit",  "FMA"},
+    {SWEEP_WIDTHS, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_W512_FMA_1T, "512 bit",  "AVX512"},
+    {SWEEP_WIDTHS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_W128_FMA_2T, "128 bit",  "FMA"},
+    {SWEEP_WIDTHS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_FMA_2T,      "256 bit",  "FMA"},
+    {SWEEP_WIDTHS, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_W512_FMA_2T, "512 bit",  "AVX512"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_U288_FMA_1T,  "288 lines",  "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_U576_FMA_1T,  "576 lines",  "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_U1152_FMA_1T, "1152 lines", "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_1T, FUNC_SKL_COREI_FMA_1T,       "1536 lines", "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_U288_FMA_2T,  "288 lines",  "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_U576_FMA_2T,  "576 lines",  "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_U1152_FMA_2T, "1152 lines", "FMA"},
+    {SWEEP_UNROLL, FUNC_SKL_COREI_FMA_2T, FUNC_SKL_COREI_FMA_2T,       "1536 lines", "FMA"},
+};
+#define NUM_SWEEP_FUNCTIONS (sizeof(sweep_functions) / sizeof(sweep_functions[0]))
+
+/*
+ * long options without a short equivalent
+ */
+#define OPT_CHUNK    256
+#define OPT_CHUNK_US 257
+#define OPT_SECONDARY 258
+#define OPT_BANDWIDTH 259
+#define OPT_SWEEP     260
+#define OPT_DATA_PATTERN 261
+#define OPT_AUTO_FUNCTION 262
+#define OPT_VERIFY 263
+#define OPT_COHERENCE 264
+#define OPT_CONFIG    265
+#define OPT_SET       266
+#define OPT_RAPL_SCHEDULE 267
+#define OPT_PSTATE_SWEEP 268
+#define OPT_DWELL     269
+#define OPT_TARGET_WATTS 270
+#define OPT_PSTATE    271
+#define OPT_CAMPAIGN  272
+#define OPT_PHASES    273
+
 /*
  * pointer for CPU bind argument (-b | --bind)
  */
 char *fsbind = NULL;
 
+/*
+ * pointer for the CPU to function mapping (-i CPULIST:ID,... | --function=CPULIST:ID,...),
+ * function of each thread, NULL if all threads run FUNCTION
+ */
+char *fsfunction = NULL;
+int *thread_function = NULL;
+
+/*
+ * pointer for the CPU to P-state mapping (--pstate=CPULIST:VALUE,...),
+ * PERF_CTL target of each thread, NULL if all threads use pstate of the run configuration
+ */
+char *fspstate = NULL;
+unsigned long *thread_pstate = NULL;
+
+/*
+ * names of the function IDs as listed by --avail, -i accepts them with or without the FUNC_ prefix
+ */
+static const char *function_names[] = {
+    NULL,
+    "FUNC_KNL_XEONPHI_AVX512_4T",
+    "FUNC_SKL_COREI_FMA_1T",
+    "FUNC_SKL_COREI_FMA_2T",
+    "FUNC_HSW_COREI_FMA_1T",
+    "FUNC_HSW_COREI_FMA_2T",
+    "FUNC_HSW_XEONEP_FMA_1T",
+    "FUNC_HSW_XEONEP_FMA_2T",
+    "FUNC_SNB_COREI_AVX_1T",
+    "FUNC_SNB_COREI_AVX_2T",
+    "FUNC_SNB_XEONEP_AVX_1T",
+    "FUNC_SNB_XEONEP_AVX_2T",
+    "FUNC_NHM_COREI_SSE2_1T",
+    "FUNC_NHM_COREI_SSE2_2T",
+    "FUNC_NHM_XEONEP_SSE2_1T",
+    "FUNC_NHM_XEONEP_SSE2_2T",
+    "FUNC_BLD_OPTERON_FMA4_1T",
+    "FUNC_MEM_NTSTORE_SSE2",
+    "FUNC_MEM_READ_SSE2",
+    "FUNC_MEM_COPY_SSE2",
+    "FUNC_MEM_TRIAD_SSE2",
+    "FUNC_SKL_COREI_L1_FMA_1T",
+    "FUNC_SKL_COREI_L1_FMA_2T",
+    "FUNC_SKL_COREI_L2_FMA_1T",
+    "FUNC_SKL_COREI_L2_FMA_2T",
+    "FUNC_SKL_COREI_L3_FMA_1T",
+    "FUNC_SKL_COREI_L3_FMA_2T",
+    "FUNC_SKL_COREI_RAM_FMA_1T",
+    "FUNC_SKL_COREI_RAM_FMA_2T",
+    "FUNC_SKL_COREI_REG_FMA_1T",
+    "FUNC_SKL_COREI_REG_FMA_2T",
+    "FUNC_SKL_COREI_W128_FMA_1T",
+    "FUNC_SKL_COREI_W128_FMA_2T",
+    "FUNC_SKL_COREI_W512_FMA_1T",
+    "FUNC_SKL_COREI_W512_FMA_2T",
+    "FUNC_SKL_COREI_SP_FMA_1T",
+    "FUNC_SKL_COREI_SP_FMA_2T",
+    "FUNC_SKL_COREI_INT16_FMA_1T",
+    "FUNC_SKL_COREI_INT16_FMA_2T",
+    "FUNC_SKL_COREI_INT8_FMA_1T",
+    "FUNC_SKL_COREI_INT8_FMA_2T",
+    "FUNC_SKL_COREI_BF16_FMA_1T",
+    "FUNC_SKL_COREI_BF16_FMA_2T",
+    "FUNC_SKL_COREI_U288_FMA_1T",
+    "FUNC_SKL_COREI_U288_FMA_2T",
+    "FUNC_SKL_COREI_U576_FMA_1T",
+    "FUNC_SKL_COREI_U576_FMA_2T",
+    "FUNC_SKL_COREI_U1152_FMA_1T",
+    "FUNC_SKL_COREI_U1152_FMA_2T",
+    "FUNC_COH_ATOMIC",
+    "FUNC_COH_PINGPONG",
+    "FUNC_COH_QUEUE",
+};
+#define NUM_FUNCTION_NAMES (sizeof(function_names) / sizeof(function_names[0]))
+
 /*
  * temporary variables
  */
@@ -111,12 +339,210 @@ cpu_set_t cpuset;
 #endif
 unsigned long long *cpu_bind;
 
+/*
+ * collect the variants of func for the selected sweep, returns the number of variants
+ */
+static unsigned int get_sweep_functions(int func, unsigned char *sweep)
+{
+    unsigned int i, n = 0;
+
+    for (i = 0; i < NUM_SWEEP_FUNCTIONS && n < MAX_SWEEP; i++) {
+        if ((sweep_functions[i].sweep == SWEEP) && (sweep_functions[i].function == func)) {
+            if (feature_available((char *)sweep_functions[i].feature)) sweep[n++] = sweep_functions[i].variant;
+            else if (verbose) printf("  --sweep: skipping %s, which requires %s\n", sweep_functions[i].label, sweep_functions[i].feature);
+        }
+    }
+
+    return n;
+}
+
+/*
+ * label of a variant in the selected sweep
+ */
+static const char *get_sweep_label(int func)
+{
+    unsigned int i;
+
+    for (i = 0; i < NUM_SWEEP_FUNCTIONS; i++) {
+        if ((sweep_functions[i].sweep == SWEEP) && (sweep_functions[i].variant == func)) return sweep_functions[i].label;
+    }
+
+    return "?";
+}
+
+static void get_buffersizes(int func, unsigned int *buffersize, unsigned long long *rambuffersize, int print);
+
+/*
+ * parse --target-watts=WATTS[/KP,KI,KD]
+ */
+static int get_target_watts(const char *arg)
+{
+    char *end;
+    int i;
+
+    TARGET_WATTS = strtod(arg, &end);
+    if ((end == arg) || (TARGET_WATTS <= 0.0)) {
+        printf("Error: power target has to be a positive number of watts: %s\n", arg);
+        return EXIT_FAILURE;
+    }
+    if (*end == '/') {
+        for (i = 0; i < 3; i++) {
+            arg = end + 1;
+            TARGET_GAINS[i] = strtod(arg, &end);
+            if ((end == arg) || (TARGET_GAINS[i] < 0.0) || (*end != ((i < 2) ? ',' : '\0'))) break;
+        }
+        if (i < 3) {
+            printf("Error: expected three gains KP,KI,KD that are not negative in --target-watts\n");
+            return EXIT_FAILURE;
+        }
+    }
+    else if (*end != '\0') {
+        printf("Error: invalid power target: %s\n", arg);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * parse --pstate-sweep=RATIOS ("x,y,z", "x-y", "x-y/step", and any combination), a range with x > y runs downwards
+ */
+static int get_pstates(const char *arg)
+{
+    char *list = strdup(arg), *item, *next, *end;
+    long first, last, step;
+
+    NUM_PSTATES = 0;
+    for (item = list; item != NULL; item = next) {
+        next = strchr(item, ',');
+        if (next) *next++ = '\0';
+        first = last = strtol(item, &end, 0);
+        step = 1;
+        if (*end == '-') last = strtol(end + 1, &end, 0);
+        if (*end == '/') step = strtol(end + 1, &end, 0);
+        if ((*end != '\0') || (step <= 0) || (first < 1) || (first > 255) || (last < 1) || (last > 255)) {
+            printf("Error: invalid P-state ratio list, ratios have to be between 1 and 255: %s\n", arg);
+            free(list);
+            return EXIT_FAILURE;
+        }
+        if (last < first) step = -step;
+        for (; (step > 0) ? (first <= last) : (first >= last); first += step) {
+            if (NUM_PSTATES == MAX_PSTATES) {
+                printf("Error: more than %d ratios in --pstate-sweep: %s\n", MAX_PSTATES, arg);
+                free(list);
+                return EXIT_FAILURE;
+            }
+            PSTATES[NUM_PSTATES++] = (unsigned char)first;
+        }
+    }
+    free(list);
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * parse --coherence=PLACEMENT[/SIZE]
+ */
+static int get_coherence(const char *arg)
+{
+    unsigned int i;
+    size_t len = strcspn(arg, "/");
+    char *end;
+
+    for (i = 0; i < sizeof(coherence_placements) / sizeof(coherence_placements[0]); i++) {
+        if ((strlen(coherence_placements[i]) == len) && (strncmp(arg, coherence_placements[i], len) == 0)) break;
+    }
+    if (i == sizeof(coherence_placements) / sizeof(coherence_placements[0])) {
+        printf("Error: unknown placement in --coherence: %s, valid values: core, package, or system\n", arg);
+        return EXIT_FAILURE;
+    }
+    COHERENCE = i;
+    if (arg[len] == '/') {
+        COHERENCE_SIZE = (unsigned int)strtoul(arg + len + 1, &end, 10);
+        if ((*end != '\0') || (COHERENCE_SIZE < 2) || (COHERENCE_SIZE > COH_MAX_GROUP)) {
+            printf("Error: group size in --coherence has to be between 2 and %d: %s\n", COH_MAX_GROUP, arg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * whether the CPUs of two threads can be in the same group of a coherence function
+ */
+static int coherence_placed(int *core, int *pkg, unsigned int t, unsigned int u)
+{
+    switch (COHERENCE) {
+      case COH_CORE:
+        return (pkg[t] == pkg[u]) && (core[t] == core[u]);
+      case COH_PACKAGE:
+        return (pkg[t] == pkg[u]) && (core[t] != core[u]);
+      default:
+        return pkg[t] != pkg[u];
+    }
+}
+
+/*
+ * groups of up to COHERENCE_SIZE threads that run the same coherence function and are placed as selected by
+ * --coherence, the threads are assigned in order, returns the number of groups, sets the group (NUM_THREADS
+ * for other functions), the slot, and the size of the group of each thread
+ */
+static unsigned int coherence_groups(int *function, unsigned int *group, unsigned int *slot, unsigned int *size)
+{
+    int *core = (int *) calloc(NUM_THREADS, sizeof(int));
+    int *pkg = (int *) calloc(NUM_THREADS, sizeof(int));
+    unsigned int t, u, v, n = 0, known = 1;
+
+    if ((core == NULL) || (pkg == NULL)) {
+        fprintf(stderr, "Error: Allocation of the coherence groups failed\n");
+        fflush(stderr);
+        exit(127);
+    }
+    for (t = 0; t < NUM_THREADS; t++) {
+        core[t] = get_core_id(cpu_bind[t]);
+        pkg[t] = get_pkg(cpu_bind[t]);
+        if ((core[t] < 0) || (pkg[t] < 0)) known = 0;
+        group[t] = NUM_THREADS;
+    }
+    if (!known) fprintf(stderr, "Warning: --coherence: unknown CPU topology, the threads are grouped in order\n");
+
+    for (t = 0; t < NUM_THREADS; t++) {
+        if (!IS_COHERENCE_FUNCTION(function[t]) || (group[t] != NUM_THREADS)) continue;
+        group[t] = n;
+        slot[t] = 0;
+        size[t] = 1;
+        for (u = t + 1; (u < NUM_THREADS) && (size[t] < COHERENCE_SIZE); u++) {
+            if ((function[u] != function[t]) || (group[u] != NUM_THREADS)) continue;
+            for (v = t; v < u; v++) {
+                if ((group[v] == n) && known && !coherence_placed(core, pkg, v, u)) break;
+            }
+            if (v < u) continue;
+            group[u] = n;
+            slot[u] = size[t]++;
+        }
+        for (u = t + 1; u < NUM_THREADS; u++) if (group[u] == n) size[u] = size[t];
+        if (size[t] == 1) {
+            fprintf(stderr, "Warning: --coherence: no other thread for CPU %llu with %s placement, it runs alone\n",
+                    cpu_bind[t], coherence_placements[COHERENCE]);
+        }
+        n++;
+    }
+    free(core);
+    free(pkg);
+
+    return n;
+}
+
 /*
  * initialize data structures
  */
 static void *init()
 {
-    unsigned int i, t;
+    unsigned int i, t, p, num_sweep, num_groups;
+    unsigned char sweep[MAX_SWEEP];
+    int *function, pkg;
+    unsigned int *coh_group, *coh_slot, *coh_size;
 
 #if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
     cpu_set(cpu_bind[0]);
@@ -170,21 +596,126 @@ static void *init()
     }
     char *barrier = (char *) calloc(NUM_THREADS, sizeof(char));
 
+    num_sweep = SWEEP ? get_sweep_functions(FUNCTION, sweep) : 0;
+    if (SWEEP && (num_sweep == 0)) {
+        fprintf(stderr, "Error: --sweep requires a function with variants, e.g., %i (FUNC_SKL_COREI_FMA_1T)\n", FUNC_SKL_COREI_FMA_1T);
+        fflush(stderr);
+        exit(127);
+    }
+
+    /* --verify: reference checksum of the payload results, computed once on the first CPU */
+    if (VERIFY) {
+        threaddata_t reference;
+
+        if (BUFFERSIZE[0] == 0) {
+            fprintf(stderr, "Error: --verify requires a function with floating point payload, not a memory or coherence function\n");
+            fflush(stderr);
+            exit(127);
+        }
+        memset(&reference, 0, sizeof(reference));
+        reference.data = mdp;
+        reference.alignment = ALIGNMENT;
+        reference.verify_function = FUNCTION;
+        reference.data_pattern = DATA_PATTERN;
+        for (i = 0; i < MAX_CACHELEVELS; i++) reference.buffersize[i] = BUFFERSIZE[i];
+        mdp->verify_reference = verify_checksum(&reference);
+        _mm_free(reference.verifyMem);
+    }
+
+    /* coherence functions: groups of threads that share COH_GROUP_BYTES of sharedMem */
+    function = (int *) calloc(NUM_THREADS, sizeof(int));
+    coh_group = (unsigned int *) calloc(NUM_THREADS, sizeof(unsigned int));
+    coh_slot = (unsigned int *) calloc(NUM_THREADS, sizeof(unsigned int));
+    coh_size = (unsigned int *) calloc(NUM_THREADS, sizeof(unsigned int));
+    if ((function == NULL) || (coh_group == NULL) || (coh_slot == NULL) || (coh_size == NULL)) {
+        fprintf(stderr, "Error: Allocation of the coherence groups failed\n");
+        fflush(stderr);
+        exit(127);
+    }
+    for (t = 0; t < NUM_THREADS; t++) function[t] = thread_function ? thread_function[t] : FUNCTION;
+    num_groups = coherence_groups(function, coh_group, coh_slot, coh_size);
+    if (num_groups) {
+        mdp->sharedMem = _mm_malloc(num_groups * COH_GROUP_BYTES, 4096);
+        if (mdp->sharedMem == NULL) {
+            fprintf(stderr, "Error: Allocation of the shared cache lines failed\n");
+            fflush(stderr);
+            exit(127);
+        }
+        memset(mdp->sharedMem, 0, num_groups * COH_GROUP_BYTES);
+        if (verbose) {
+            printf("  --coherence: %u group(s), %s placement\n", num_groups, coherence_placements[COHERENCE]);
+            for (t = 0; t < NUM_THREADS; t++) {
+                if (coh_group[t] < NUM_THREADS) printf("    - Thread %u on CPU %llu: group %u, slot %u of %u\n", t, cpu_bind[t], coh_group[t], coh_slot[t], coh_size[t]);
+            }
+            printf("\n");
+        }
+    }
+
     // create worker threads
     for (t = 0; t < NUM_THREADS; t++) {
         mdp->ack = 0;
         mdp->threaddata[t].thread_id = t;
         mdp->threaddata[t].cpu_id = cpu_bind[t];
+        pkg = get_pkg(cpu_bind[t]);
+        mdp->threaddata[t].package = ((pkg < 0) || (pkg >= MAX_PACKAGES)) ? 0 : (unsigned int) pkg;
         mdp->threaddata[t].data = mdp;
-        mdp->threaddata[t].buffersizeMem = BUFFERSIZEMEM;
+        mdp->threaddata[t].FUNCTION = thread_function ? thread_function[t] : FUNCTION;
+        if (mdp->threaddata[t].FUNCTION == FUNCTION) {
+            mdp->threaddata[t].buffersizeMem = BUFFERSIZEMEM;
+            for (i = 0; i < MAX_CACHELEVELS; i++) mdp->threaddata[t].buffersize[i] = BUFFERSIZE[i];
+            mdp->threaddata[t].buffersize[MAX_CACHELEVELS] = RAMBUFFERSIZE;
+        }
+        else { /* -i CPULIST:ID,...: buffer of the function of this thread */
+            unsigned int buffersize[MAX_CACHELEVELS];
+            unsigned long long rambuffersize;
+
+            get_buffersizes(mdp->threaddata[t].FUNCTION, buffersize, &rambuffersize, 0);
+            mdp->threaddata[t].buffersizeMem = sizeof(char) * (2 * buffersize[0] + buffersize[1] + buffersize[2] + rambuffersize +
+                                                               ALIGNMENT + 2 * sizeof(unsigned long long));
+            for (i = 0; i < MAX_CACHELEVELS; i++) mdp->threaddata[t].buffersize[i] = buffersize[i];
+            mdp->threaddata[t].buffersize[MAX_CACHELEVELS] = rambuffersize;
+        }
         mdp->threaddata[t].iterations = 0;
+        mdp->threaddata[t].chunk = CHUNK;
+        mdp->threaddata[t].chunk_us = CHUNK_US;
+        mdp->threaddata[t].bandwidth = BANDWIDTH;
         mdp->threaddata[t].flops = 0;
         mdp->threaddata[t].bytes = 0;
+        for (p = 0; p < NUM_PHASES; p++) {
+            mdp->threaddata[t].phase_iterations[p] = 0;
+            mdp->threaddata[t].phase_tsc[p] = 0;
+        }
+        memset(mdp->threaddata[t].secondary_iterations, 0, sizeof(mdp->threaddata[t].secondary_iterations));
+        memset(mdp->threaddata[t].secondary_tsc, 0, sizeof(mdp->threaddata[t].secondary_tsc));
         mdp->threaddata[t].alignment = ALIGNMENT;
-        mdp->threaddata[t].FUNCTION = FUNCTION;
+        mdp->threaddata[t].secondary = SECONDARY;
+        mdp->threaddata[t].data_pattern = DATA_PATTERN;
+        mdp->threaddata[t].shift_seed = data_pattern_shift_seed(DATA_PATTERN, t);
+        memcpy(mdp->threaddata[t].sweep, sweep, sizeof(sweep));
+        mdp->threaddata[t].num_sweep = num_sweep;
+        mdp->threaddata[t].sweep_pos = 0;
+        memset(mdp->threaddata[t].sweepdata, 0, sizeof(mdp->threaddata[t].sweepdata));
+        mdp->threaddata[t].sweep_start = 0;
+        memset(mdp->threaddata[t].pstatedata, 0, sizeof(mdp->threaddata[t].pstatedata));
+        mdp->threaddata[t].pstate_pos = NUM_PSTATES;
+        mdp->threaddata[t].pstate = (thread_pstate && (thread_pstate[t] != PSTATE_UNLISTED)) ? thread_pstate[t] : FSCONFIG.pstate;
+        mdp->threaddata[t].perf_saved_valid = 0;
+        mdp->threaddata[t].pstate_start = 0;
         mdp->threaddata[t].period = PERIOD;
+        mdp->threaddata[t].verify_tsc = VERIFY * (cpuinfo->clockrate / 1000);
+        mdp->threaddata[t].verify_next = 0;
+        mdp->threaddata[t].verify_cycles = 0;
+        mdp->threaddata[t].verify_checks = 0;
+        mdp->threaddata[t].verify_errors = 0;
+        mdp->threaddata[t].verifyMem = NULL;
+        mdp->threaddata[t].verify_function = FUNCTION;
+        mdp->threaddata[t].addrShared = (coh_group[t] < NUM_THREADS) ? (unsigned long long)(mdp->sharedMem + coh_group[t] * COH_GROUP_BYTES) : 0;
+        mdp->threaddata[t].coh_slot = coh_slot[t];
+        mdp->threaddata[t].coh_size = coh_size[t];
         mdp->threaddata[t].iter = 0;
         mdp->threaddata[t].msrdata = NULL;
+        mdp->threaddata[t].msrdata_size = 0;
+        mdp->threaddata[t].config = &FSCONFIG;
         mdp->threaddata[t].numthreads = NUM_THREADS;
         mdp->threaddata[t].barrierdata = barrier;
         mdp->thread_comm[t] = THREAD_INIT;
@@ -197,6 +728,10 @@ static void *init()
         }
     }
     mdp->ack = 0;
+    free(function);
+    free(coh_group);
+    free(coh_slot);
+    free(coh_size);
 
 #if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
     cpu_set(cpu_bind[0]);
@@ -253,6 +788,76 @@ static void list_functions(){
   else printf("  %4.4s | %.30s | no\n","15","FUNC_NHM_XEONEP_SSE2_2T                             ");
   if (feature_available("FMA4")) printf("  %4.4s | %.30s | yes\n","16","FUNC_BLD_OPTERON_FMA4_1T                             ");
   else printf("  %4.4s | %.30s | no\n","16","FUNC_BLD_OPTERON_FMA4_1T                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","17","FUNC_MEM_NTSTORE_SSE2                             ");
+  else printf("  %4.4s | %.30s | no\n","17","FUNC_MEM_NTSTORE_SSE2                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","18","FUNC_MEM_READ_SSE2                             ");
+  else printf("  %4.4s | %.30s | no\n","18","FUNC_MEM_READ_SSE2                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","19","FUNC_MEM_COPY_SSE2                             ");
+  else printf("  %4.4s | %.30s | no\n","19","FUNC_MEM_COPY_SSE2                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","20","FUNC_MEM_TRIAD_SSE2                             ");
+  else printf("  %4.4s | %.30s | no\n","20","FUNC_MEM_TRIAD_SSE2                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","21","FUNC_SKL_COREI_L1_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","21","FUNC_SKL_COREI_L1_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","22","FUNC_SKL_COREI_L1_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","22","FUNC_SKL_COREI_L1_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","23","FUNC_SKL_COREI_L2_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","23","FUNC_SKL_COREI_L2_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","24","FUNC_SKL_COREI_L2_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","24","FUNC_SKL_COREI_L2_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","25","FUNC_SKL_COREI_L3_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","25","FUNC_SKL_COREI_L3_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","26","FUNC_SKL_COREI_L3_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","26","FUNC_SKL_COREI_L3_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","27","FUNC_SKL_COREI_RAM_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","27","FUNC_SKL_COREI_RAM_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","28","FUNC_SKL_COREI_RAM_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","28","FUNC_SKL_COREI_RAM_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","29","FUNC_SKL_COREI_REG_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","29","FUNC_SKL_COREI_REG_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","30","FUNC_SKL_COREI_REG_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","30","FUNC_SKL_COREI_REG_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","31","FUNC_SKL_COREI_W128_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","31","FUNC_SKL_COREI_W128_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","32","FUNC_SKL_COREI_W128_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","32","FUNC_SKL_COREI_W128_FMA_2T                             ");
+  if (feature_available("AVX512")) printf("  %4.4s | %.30s | yes\n","33","FUNC_SKL_COREI_W512_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","33","FUNC_SKL_COREI_W512_FMA_1T                             ");
+  if (feature_available("AVX512")) printf("  %4.4s | %.30s | yes\n","34","FUNC_SKL_COREI_W512_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","34","FUNC_SKL_COREI_W512_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","35","FUNC_SKL_COREI_SP_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","35","FUNC_SKL_COREI_SP_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","36","FUNC_SKL_COREI_SP_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","36","FUNC_SKL_COREI_SP_FMA_2T                             ");
+  if (feature_available("AVX2")) printf("  %4.4s | %.30s | yes\n","37","FUNC_SKL_COREI_INT16_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","37","FUNC_SKL_COREI_INT16_FMA_1T                             ");
+  if (feature_available("AVX2")) printf("  %4.4s | %.30s | yes\n","38","FUNC_SKL_COREI_INT16_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","38","FUNC_SKL_COREI_INT16_FMA_2T                             ");
+  if (feature_available("AVX512_VNNI")) printf("  %4.4s | %.30s | yes\n","39","FUNC_SKL_COREI_INT8_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","39","FUNC_SKL_COREI_INT8_FMA_1T                             ");
+  if (feature_available("AVX512_VNNI")) printf("  %4.4s | %.30s | yes\n","40","FUNC_SKL_COREI_INT8_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","40","FUNC_SKL_COREI_INT8_FMA_2T                             ");
+  if (feature_available("AVX512_BF16")) printf("  %4.4s | %.30s | yes\n","41","FUNC_SKL_COREI_BF16_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","41","FUNC_SKL_COREI_BF16_FMA_1T                             ");
+  if (feature_available("AVX512_BF16")) printf("  %4.4s | %.30s | yes\n","42","FUNC_SKL_COREI_BF16_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","42","FUNC_SKL_COREI_BF16_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","43","FUNC_SKL_COREI_U288_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","43","FUNC_SKL_COREI_U288_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","44","FUNC_SKL_COREI_U288_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","44","FUNC_SKL_COREI_U288_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","45","FUNC_SKL_COREI_U576_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","45","FUNC_SKL_COREI_U576_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","46","FUNC_SKL_COREI_U576_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","46","FUNC_SKL_COREI_U576_FMA_2T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","47","FUNC_SKL_COREI_U1152_FMA_1T                             ");
+  else printf("  %4.4s | %.30s | no\n","47","FUNC_SKL_COREI_U1152_FMA_1T                             ");
+  if (feature_available("FMA")) printf("  %4.4s | %.30s | yes\n","48","FUNC_SKL_COREI_U1152_FMA_2T                             ");
+  else printf("  %4.4s | %.30s | no\n","48","FUNC_SKL_COREI_U1152_FMA_2T                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","49","FUNC_COH_ATOMIC                             ");
+  else printf("  %4.4s | %.30s | no\n","49","FUNC_COH_ATOMIC                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","50","FUNC_COH_PINGPONG                             ");
+  else printf("  %4.4s | %.30s | no\n","50","FUNC_COH_PINGPONG                             ");
+  if (feature_available("SSE2")) printf("  %4.4s | %.30s | yes\n","51","FUNC_COH_QUEUE                             ");
+  else printf("  %4.4s | %.30s | no\n","51","FUNC_COH_QUEUE                             ");
 
   return;
 }
@@ -357,11 +962,937 @@ static int get_function(unsigned int id){
            fprintf(stderr, "\nError: Function 16 (\"FUNC_BLD_OPTERON_FMA4_1T\") requires FMA4, which is not supported by the processor.\n\n");
          }
          break;
+       case 17:
+         if (feature_available("SSE2")) func = FUNC_MEM_NTSTORE_SSE2;
+         else{
+           fprintf(stderr, "\nError: Function 17 (\"FUNC_MEM_NTSTORE_SSE2\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 18:
+         if (feature_available("SSE2")) func = FUNC_MEM_READ_SSE2;
+         else{
+           fprintf(stderr, "\nError: Function 18 (\"FUNC_MEM_READ_SSE2\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 19:
+         if (feature_available("SSE2")) func = FUNC_MEM_COPY_SSE2;
+         else{
+           fprintf(stderr, "\nError: Function 19 (\"FUNC_MEM_COPY_SSE2\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 20:
+         if (feature_available("SSE2")) func = FUNC_MEM_TRIAD_SSE2;
+         else{
+           fprintf(stderr, "\nError: Function 20 (\"FUNC_MEM_TRIAD_SSE2\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 21:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_L1_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 21 (\"FUNC_SKL_COREI_L1_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 22:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_L1_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 22 (\"FUNC_SKL_COREI_L1_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 23:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_L2_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 23 (\"FUNC_SKL_COREI_L2_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 24:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_L2_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 24 (\"FUNC_SKL_COREI_L2_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 25:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_L3_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 25 (\"FUNC_SKL_COREI_L3_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 26:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_L3_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 26 (\"FUNC_SKL_COREI_L3_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 27:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_RAM_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 27 (\"FUNC_SKL_COREI_RAM_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 28:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_RAM_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 28 (\"FUNC_SKL_COREI_RAM_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 29:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_REG_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 29 (\"FUNC_SKL_COREI_REG_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 30:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_REG_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 30 (\"FUNC_SKL_COREI_REG_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 31:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_W128_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 31 (\"FUNC_SKL_COREI_W128_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 32:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_W128_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 32 (\"FUNC_SKL_COREI_W128_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 33:
+         if (feature_available("AVX512")) func = FUNC_SKL_COREI_W512_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 33 (\"FUNC_SKL_COREI_W512_FMA_1T\") requires AVX512, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 34:
+         if (feature_available("AVX512")) func = FUNC_SKL_COREI_W512_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 34 (\"FUNC_SKL_COREI_W512_FMA_2T\") requires AVX512, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 35:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_SP_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 35 (\"FUNC_SKL_COREI_SP_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 36:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_SP_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 36 (\"FUNC_SKL_COREI_SP_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 37:
+         if (feature_available("AVX2")) func = FUNC_SKL_COREI_INT16_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 37 (\"FUNC_SKL_COREI_INT16_FMA_1T\") requires AVX2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 38:
+         if (feature_available("AVX2")) func = FUNC_SKL_COREI_INT16_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 38 (\"FUNC_SKL_COREI_INT16_FMA_2T\") requires AVX2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 39:
+         if (feature_available("AVX512_VNNI")) func = FUNC_SKL_COREI_INT8_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 39 (\"FUNC_SKL_COREI_INT8_FMA_1T\") requires AVX512_VNNI, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 40:
+         if (feature_available("AVX512_VNNI")) func = FUNC_SKL_COREI_INT8_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 40 (\"FUNC_SKL_COREI_INT8_FMA_2T\") requires AVX512_VNNI, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 41:
+         if (feature_available("AVX512_BF16")) func = FUNC_SKL_COREI_BF16_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 41 (\"FUNC_SKL_COREI_BF16_FMA_1T\") requires AVX512_BF16, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 42:
+         if (feature_available("AVX512_BF16")) func = FUNC_SKL_COREI_BF16_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 42 (\"FUNC_SKL_COREI_BF16_FMA_2T\") requires AVX512_BF16, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 43:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_U288_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 43 (\"FUNC_SKL_COREI_U288_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 44:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_U288_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 44 (\"FUNC_SKL_COREI_U288_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 45:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_U576_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 45 (\"FUNC_SKL_COREI_U576_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 46:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_U576_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 46 (\"FUNC_SKL_COREI_U576_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 47:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_U1152_FMA_1T;
+         else{
+           fprintf(stderr, "\nError: Function 47 (\"FUNC_SKL_COREI_U1152_FMA_1T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 48:
+         if (feature_available("FMA")) func = FUNC_SKL_COREI_U1152_FMA_2T;
+         else{
+           fprintf(stderr, "\nError: Function 48 (\"FUNC_SKL_COREI_U1152_FMA_2T\") requires FMA, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 49:
+         if (feature_available("SSE2")) func = FUNC_COH_ATOMIC;
+         else{
+           fprintf(stderr, "\nError: Function 49 (\"FUNC_COH_ATOMIC\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 50:
+         if (feature_available("SSE2")) func = FUNC_COH_PINGPONG;
+         else{
+           fprintf(stderr, "\nError: Function 50 (\"FUNC_COH_PINGPONG\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
+       case 51:
+         if (feature_available("SSE2")) func = FUNC_COH_QUEUE;
+         else{
+           fprintf(stderr, "\nError: Function 51 (\"FUNC_COH_QUEUE\") requires SSE2, which is not supported by the processor.\n\n");
+         }
+         break;
        default:
          fprintf(stderr, "\nError: unknown function id: %s, see --avail for available ids\n\n", optarg);
     }
 
-    return func;
+    return func;
+}
+
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+/*
+ * adds the CPUs of a CPULIST ("x,y,z", "x-y", "x-y/step", and any combination) to set, returns the number of CPUs
+ */
+static unsigned int parse_cpulist(const char *list, cpu_set_t *set, const char *option)
+{
+    char *p,*q,*r,*s,*t,*copy;
+    int p_val=0,r_val=0,s_val=0,error=0;
+    unsigned int i, n=0;
+
+    errno=0;
+    p=copy=strdup(list);
+    while(p!=NULL) {
+        q=strstr(p,",");
+        if (q) {
+            *q='\0';
+            q++;
+        }
+        s=strstr(p,"/");
+        if (s) {
+            *s='\0';
+            s++;
+            s_val=(int)strtol(s,&t,10);
+            if ((errno) || ((strcmp(t,"\0") && (t[0] !=','))) ) error++;
+        }
+        r=strstr(p,"-");
+        if (r) {
+            *r='\0';
+            r++;
+            r_val=(int)strtol(r,&t,10);
+            if ((errno) || ((strcmp(t,"\0") && (t[0] !=',') && (t[0] !='/'))) ) error++;
+        }
+        p_val=(int)strtol(p,&t,10);
+        if ((errno) || (p_val < 0) || (strcmp(t,"\0"))) error++;
+        if(error) {
+            fprintf(stderr, "Error: invalid symbols in CPU list: %s\n",list);
+            fflush(stderr);
+            exit(127);
+        }
+        if ((s) && (s_val<=0)) {
+            fprintf(stderr, "Error: s has to be >= 0 in x-y/s expressions of CPU list: %s\n",list);
+            fflush(stderr);
+            exit(127);
+        }
+        if ((r) && (r_val < p_val)) {
+            fprintf(stderr, "Error: y has to be >= x in x-y expressions of CPU list: %s\n",list);
+            fflush(stderr);
+            exit(127);
+        }
+        if ((s)&&(r)) for (i=p_val; (int)i<=r_val; i+=s_val) {
+            ADD_CPU_SET(i,*set,option);
+            n++;
+        }
+        else if (r) for (i=p_val; (int)i<=r_val; i++) {
+            ADD_CPU_SET(i,*set,option);
+            n++;
+        }
+        else {
+            ADD_CPU_SET(p_val,*set,option);
+            n++;
+        }
+        p=q;
+    }
+    free(copy);
+
+    return n;
+}
+#endif
+
+/*
+ * L1, L2, L3, and RAM part of the buffer of the function func, print = 1 reports the code path and the sizes
+ */
+static void get_buffersizes(int func, unsigned int *buffersize, unsigned long long *rambuffersize, int print)
+{
+    unsigned int i, threads = 1;
+
+    switch (func) {
+    case FUNC_KNL_XEONPHI_AVX512_4T:
+        buffersize[0] = 8192;
+        buffersize[1] = 131072;
+        buffersize[2] = 59069781;
+        *rambuffersize = 6553600;
+        threads = 4;
+        if (print) {
+            printf("\n  Taking AVX512 path optimized for Knights_Landing - 4 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_HSW_COREI_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Haswell - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_HSW_COREI_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Haswell - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_HSW_XEONEP_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 2621440;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Haswell-EP - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_HSW_XEONEP_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 1310720;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Haswell-EP - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SNB_COREI_AVX_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking AVX path optimized for Sandy Bridge - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SNB_COREI_AVX_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking AVX path optimized for Sandy Bridge - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SNB_XEONEP_AVX_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 2621440;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking AVX path optimized for Sandy Bridge-EP - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SNB_XEONEP_AVX_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 1310720;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking AVX path optimized for Sandy Bridge-EP - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_NHM_COREI_SSE2_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking SSE2 path optimized for Nehalem - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_NHM_COREI_SSE2_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking SSE2 path optimized for Nehalem - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_NHM_XEONEP_SSE2_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 2097152;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking SSE2 path optimized for Nehalem-EP - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_NHM_XEONEP_SSE2_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 1048576;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking SSE2 path optimized for Nehalem-EP - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_BLD_OPTERON_FMA4_1T:
+        buffersize[0] = 16384;
+        buffersize[1] = 1048576;
+        buffersize[2] = 786432;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA4 path optimized for Bulldozer - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_L1_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (L1_L only) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_L1_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (L1_L only) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_L2_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (L2_L only) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_L2_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (L2_L only) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_L3_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (L3_L only) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_L3_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (L3_L only) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_RAM_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (RAM_L only) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_RAM_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (RAM_L only) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_REG_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (REG only) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_REG_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (REG only) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_W128_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (128 bit) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_W128_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (128 bit) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_W512_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (512 bit) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_W512_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (512 bit) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_SP_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (sp) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_SP_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (sp) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_INT16_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (int16) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_INT16_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (int16) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_INT8_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (int8) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_INT8_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (int8) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_BF16_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (bf16) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_BF16_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (bf16) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_U288_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (288 lines) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_U288_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (288 lines) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_U576_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (576 lines) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_U576_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (576 lines) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_U1152_FMA_1T:
+        buffersize[0] = 32768;
+        buffersize[1] = 262144;
+        buffersize[2] = 1572864;
+        *rambuffersize = 104857600;
+        threads = 1;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (1152 lines) - 1 thread(s) per core");
+        }
+        break;
+    case FUNC_SKL_COREI_U1152_FMA_2T:
+        buffersize[0] = 16384;
+        buffersize[1] = 131072;
+        buffersize[2] = 786432;
+        *rambuffersize = 52428800;
+        threads = 2;
+        if (print) {
+            printf("\n  Taking FMA path optimized for Skylake (1152 lines) - 2 thread(s) per core");
+        }
+        break;
+    case FUNC_COH_ATOMIC:
+    case FUNC_COH_PINGPONG:
+    case FUNC_COH_QUEUE:
+        buffersize[0] = 0;
+        buffersize[1] = 0;
+        buffersize[2] = 0;
+        *rambuffersize = COH_LINE;
+        if (print) {
+            printf("\n  Taking cache line contention path, groups of %u threads, %s placement\n\n", COHERENCE_SIZE, coherence_placements[COHERENCE]);
+        }
+        break;
+    case FUNC_MEM_NTSTORE_SSE2:
+    case FUNC_MEM_READ_SSE2:
+    case FUNC_MEM_COPY_SSE2:
+    case FUNC_MEM_TRIAD_SSE2:
+        buffersize[0] = 0;
+        buffersize[1] = 0;
+        buffersize[2] = 0;
+        *rambuffersize = 3 * MEM_ARRAYSIZE;
+        if (print) {
+            printf("\n  Taking memory bandwidth path (SSE2)");
+            if (BANDWIDTH) printf(", target bandwidth %llu MB/s per thread", BANDWIDTH);
+            printf("\n  Used buffersizes per thread:\n");
+            printf("    - Memory: 3 x %d Bytes\n\n", MEM_ARRAYSIZE);
+        }
+        break;
+      default:
+        fprintf(stderr, "Internal Error: missing code-path %i!\n",func);
+        exit(1);
+    }
+
+    /* L1, L2, and L3 part of the buffer: share of each thread in the detected caches, the sizes above are used for caches that are not detected */
+    if (buffersize[0] > 0) {
+        cache_buffersizes(cpuinfo, threads, buffersize);
+        if (print) {
+            printf("\n  Used buffersizes per thread:\n");
+            for (i = 0; i < MAX_CACHELEVELS; i++) if (buffersize[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, buffersize[i]);
+            printf("    - Memory: %llu Bytes\n\n", *rambuffersize);
+        }
+    }
+
+}
+
+/*
+ * function ID of a number or a name as listed by --avail (case insensitive, FUNC_ is optional), 0 if unknown
+ */
+static unsigned int get_function_id(const char *name)
+{
+    unsigned int id;
+    char *end;
+
+    id = (unsigned int)strtoul(name, &end, 10);
+    if ((end != name) && (*end == '\0')) return id;
+    for (id = 1; id < NUM_FUNCTION_NAMES; id++) {
+        if ((strcasecmp(name, function_names[id]) == 0) || (strcasecmp(name, function_names[id] + strlen("FUNC_")) == 0)) return id;
+    }
+
+    return 0;
+}
+
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+/*
+ * sets thread_function for the threads whose CPU is listed in map ("CPULIST:ID[,CPULIST:ID...]"),
+ * the other threads keep FUNC_NOT_DEFINED
+ */
+static void map_functions(const char *map)
+{
+    char *list, *group, *colon, *end;
+    cpu_set_t set;
+    unsigned int t, id, n;
+    int func;
+
+    thread_function = (int *) calloc(NUM_THREADS, sizeof(int));
+    list = strdup(map);
+    if ((thread_function == NULL) || (list == NULL)) {
+        fprintf(stderr, "Error: Allocation of the function mapping failed\n");
+        fflush(stderr);
+        exit(127);
+    }
+    for (group = list; group != NULL; group = end) {
+        colon = strchr(group, ':');
+        if (colon == NULL) {
+            fprintf(stderr, "Error: missing function after CPU list %s in -i/--function\n", group);
+            exit(127);
+        }
+        *colon = '\0';
+        end = strchr(colon + 1, ',');
+        if (end) *end++ = '\0';
+        id = get_function_id(colon + 1);
+        if (id == 0) {
+            fprintf(stderr, "\nError: unknown function: %s, see --avail for available functions\n\n", colon + 1);
+            exit(127);
+        }
+        func = get_function(id);
+        if (func == FUNC_UNKNOWN) exit(127);
+        CPU_ZERO(&set);
+        parse_cpulist(group, &set, "-i/--function");
+        for (t = 0, n = 0; t < NUM_THREADS; t++) {
+            if (CPU_ISSET(cpu_bind[t], &set)) {
+                thread_function[t] = func;
+                n++;
+            }
+        }
+        if (n == 0) fprintf(stderr, "Warning: no thread runs on the CPUs %s of -i/--function\n", group);
+    }
+    free(list);
+}
+
+/*
+ * sets thread_pstate for the threads whose CPU is listed in map ("CPULIST:VALUE[,CPULIST:VALUE...]"),
+ * the other threads get PSTATE_UNLISTED and use pstate of the run configuration (of each run of --campaign)
+ */
+static void map_pstates(const char *map)
+{
+    char *list, *group, *colon, *end, *value_end;
+    cpu_set_t set;
+    unsigned int t, n;
+    unsigned long value;
+
+    thread_pstate = (unsigned long *) calloc(NUM_THREADS, sizeof(unsigned long));
+    list = strdup(map);
+    if ((thread_pstate == NULL) || (list == NULL)) {
+        fprintf(stderr, "Error: Allocation of the P-state mapping failed\n");
+        fflush(stderr);
+        exit(127);
+    }
+    for (t = 0; t < NUM_THREADS; t++) thread_pstate[t] = PSTATE_UNLISTED;
+    for (group = list; group != NULL; group = end) {
+        colon = strchr(group, ':');
+        if (colon == NULL) {
+            fprintf(stderr, "Error: missing PERF_CTL value after CPU list %s in --pstate\n", group);
+            exit(127);
+        }
+        *colon = '\0';
+        end = strchr(colon + 1, ',');
+        if (end) *end++ = '\0';
+        errno = 0;
+        value = strtoul(colon + 1, &value_end, 0);
+        if ((errno != 0) || (value_end == colon + 1) || (*value_end != '\0') || (value > 0xFFFF)) {
+            fprintf(stderr, "Error: PERF_CTL value in --pstate has to be between 0 and 0xFFFF: %s\n", colon + 1);
+            exit(127);
+        }
+        CPU_ZERO(&set);
+        parse_cpulist(group, &set, "--pstate");
+        for (t = 0, n = 0; t < NUM_THREADS; t++) {
+            if (CPU_ISSET(cpu_bind[t], &set)) {
+                thread_pstate[t] = value;
+                n++;
+            }
+        }
+        if (n == 0) fprintf(stderr, "Warning: no thread runs on the CPUs %s of --pstate\n", group);
+    }
+    free(list);
+}
+#endif
+
+/*
+ * sets the active threads of the steps of PHASES, cores=CPULIST selects them by CPU
+ */
+static void map_phases()
+{
+    phase_step_t *step;
+    unsigned int i;
+
+    for (i = 0; i < PHASES.num_steps; i++) {
+        step = &PHASES.steps[i];
+        if (step->type != PHASE_STEP_RUN) continue;
+        if (step->workload == PHASE_IDLE) {
+            step->num_active = 0;
+            continue;
+        }
+        step->num_active = NUM_THREADS;
+        if (step->cores == NULL) continue;
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+        cpu_set_t set;
+        unsigned int t;
+
+        step->active = (unsigned char *) calloc(NUM_THREADS, sizeof(unsigned char));
+        if (step->active == NULL) {
+            fprintf(stderr, "Error: Allocation of the phase sequence failed\n");
+            fflush(stderr);
+            exit(127);
+        }
+        CPU_ZERO(&set);
+        parse_cpulist(step->cores, &set, "--phases");
+        for (t = 0, step->num_active = 0; t < NUM_THREADS; t++) {
+            if (CPU_ISSET(cpu_bind[t], &set)) {
+                step->active[t] = 1;
+                step->num_active++;
+            }
+        }
+        if (step->num_active == 0) fprintf(stderr, "Warning: %s:%u: no thread runs on the CPUs %s\n", fsphases, step->line, step->cores);
+#else
+        fprintf(stderr, "Error: %s:%u: cores requires CPU binding (AFFINITY)\n", fsphases, step->line);
+        exit(127);
+#endif
+    }
 }
 
 /*
@@ -410,7 +1941,7 @@ static void evaluate_environment()
                 exit( EACCES );
               }
             }
-            ADD_CPU_SET(current_cpu,cpuset);
+            ADD_CPU_SET(current_cpu,cpuset,"-n/--threads");
             /* next cpu for next thread (or one of the following) */
             current_cpu++;
           }
@@ -427,64 +1958,8 @@ static void evaluate_environment()
     }
 #if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
     else { // parse CPULIST for binding
-        char *p,*q,*r,*s,*t;
-        int p_val=0,r_val=0,s_val=0,error=0;
-
         CPU_ZERO(&cpuset);
-        errno=0;
-        p=strdup(fsbind);
-        while(p!=NULL) {
-            q=strstr(p,",");
-            if (q) {
-                *q='\0';
-                q++;
-            }
-            s=strstr(p,"/");
-            if (s) {
-                *s='\0';
-                s++;
-                s_val=(int)strtol(s,&t,10);
-                if ((errno) || ((strcmp(t,"\0") && (t[0] !=','))) ) error++;
-            }
-            r=strstr(p,"-");
-            if (r) {
-                *r='\0';
-                r++;
-                r_val=(int)strtol(r,&t,10);
-                if ((errno) || ((strcmp(t,"\0") && (t[0] !=',') && (t[0] !='/'))) ) error++;
-            }
-            p_val=(int)strtol(p,&t,10);
-            if ((errno) || (p_val < 0) || (strcmp(t,"\0"))) error++;
-            if(error) {
-                fprintf(stderr, "Error: invalid symbols in CPU list: %s\n",fsbind);
-                fflush(stderr);
-                exit(127);
-            }
-            if ((s) && (s_val<=0)) {
-                fprintf(stderr, "Error: s has to be >= 0 in x-y/s expressions of CPU list: %s\n",fsbind);
-                fflush(stderr);
-                exit(127);
-            }
-            if ((r) && (r_val < p_val)) {
-                fprintf(stderr, "Error: y has to be >= x in x-y expressions of CPU list: %s\n",fsbind);
-                fflush(stderr);
-                exit(127);
-            }
-            if ((s)&&(r)) for (i=p_val; (int)i<=r_val; i+=s_val) {
-                ADD_CPU_SET(i,cpuset);
-                NUM_THREADS++;
-            }
-            else if (r) for (i=p_val; (int)i<=r_val; i++) {
-                ADD_CPU_SET(i,cpuset);
-                NUM_THREADS++;
-            }
-            else {
-                ADD_CPU_SET(p_val,cpuset);
-                NUM_THREADS++;
-            }
-            p=q;
-        }
-        free(p);
+        NUM_THREADS = parse_cpulist(fsbind, &cpuset, "-b/--bind");
     }
 #endif
 
@@ -524,6 +1999,37 @@ static void evaluate_environment()
         exit(1);
     }
 
+    /* --pstate CPULIST:VALUE,...: PERF_CTL target of each listed thread */
+    if (fspstate != NULL) {
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+        map_pstates(fspstate);
+#else
+        fprintf(stderr, "Error: --pstate requires CPU binding (AFFINITY), use --set pstate=VALUE for all CPUs\n");
+        exit(127);
+#endif
+    }
+
+    /* --phases: threads that run each step */
+    if (fsphases != NULL) map_phases();
+
+    /* -i CPULIST:ID,...: function of each listed thread, FUNCTION is selected as usual for the other threads */
+    if (fsfunction != NULL) {
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+        map_functions(fsfunction);
+        for (i = 0; (i < NUM_THREADS) && (thread_function[i] != FUNC_NOT_DEFINED); i++);
+        if ((i == NUM_THREADS) && (FUNCTION == FUNC_NOT_DEFINED)) FUNCTION = thread_function[0];
+#else
+        fprintf(stderr, "Error: CPU lists in -i/--function require CPU binding (AFFINITY)\n");
+        exit(127);
+#endif
+    }
+
+    /* --auto-function: measure the usable functions instead of selecting one by family and model */
+    if (AUTO_FUNCTION) {
+        if (FUNCTION != FUNC_NOT_DEFINED) fprintf(stderr, "Warning: --function overrides --auto-function\n");
+        else FUNCTION = auto_function(cpuinfo, cpu_bind, NUM_THREADS, AUTO_FUNCTION);
+    }
+
     if (FUNCTION == FUNC_NOT_DEFINED){
      if ((strcmp("GenuineIntel", cpuinfo->vendor) == 0) || (strcmp("AuthenticAMD", cpuinfo->vendor) == 0))
      {
@@ -769,209 +2275,66 @@ static void evaluate_environment()
     }
 
 
-    switch (FUNCTION) {
-    case FUNC_KNL_XEONPHI_AVX512_4T:
-        BUFFERSIZE[0] = 8192;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 59069781;
-        RAMBUFFERSIZE = 6553600;
-        if (verbose) {
-            printf("\n  Taking AVX512 path optimized for Knights_Landing - 4 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_SKL_COREI_FMA_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 1572864;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking FMA path optimized for Skylake - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_SKL_COREI_FMA_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 786432;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking FMA path optimized for Skylake - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_HSW_COREI_FMA_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 1572864;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking FMA path optimized for Haswell - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_HSW_COREI_FMA_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 786432;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking FMA path optimized for Haswell - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_HSW_XEONEP_FMA_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 2621440;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking FMA path optimized for Haswell-EP - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_HSW_XEONEP_FMA_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 1310720;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking FMA path optimized for Haswell-EP - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_SNB_COREI_AVX_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 1572864;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking AVX path optimized for Sandy Bridge - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_SNB_COREI_AVX_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 786432;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking AVX path optimized for Sandy Bridge - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_SNB_XEONEP_AVX_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 2621440;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking AVX path optimized for Sandy Bridge-EP - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_SNB_XEONEP_AVX_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 1310720;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking AVX path optimized for Sandy Bridge-EP - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_NHM_COREI_SSE2_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 1572864;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking SSE2 path optimized for Nehalem - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_NHM_COREI_SSE2_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 786432;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking SSE2 path optimized for Nehalem - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
-        }
-        break;
-    case FUNC_NHM_XEONEP_SSE2_1T:
-        BUFFERSIZE[0] = 32768;
-        BUFFERSIZE[1] = 262144;
-        BUFFERSIZE[2] = 2097152;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking SSE2 path optimized for Nehalem-EP - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
+    get_buffersizes(FUNCTION, BUFFERSIZE, &RAMBUFFERSIZE, verbose);
+
+    if (thread_function != NULL) {
+        if (verbose) printf("  Functions per thread:\n");
+        for (i = 0; i < NUM_THREADS; i++) {
+            if (thread_function[i] == FUNC_NOT_DEFINED) thread_function[i] = FUNCTION;
+            if (verbose) printf("    - Thread %u on CPU %llu: %s\n", i, cpu_bind[i], function_names[thread_function[i]]);
         }
-        break;
-    case FUNC_NHM_XEONEP_SSE2_2T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 131072;
-        BUFFERSIZE[2] = 1048576;
-        RAMBUFFERSIZE = 52428800;
-        if (verbose) {
-            printf("\n  Taking SSE2 path optimized for Nehalem-EP - 2 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
+        if (verbose) printf("\n");
+    }
+}
+
+/*
+ * --pstate-sweep: frequency, package power, and payload rates of each ratio, printed and written to file
+ */
+static void pstate_report(const char *file)
+{
+    FILE *out = fopen(file, "w");
+    unsigned long long iterations, aperf, mperf;
+    double rate, flops, bytes, watts, ghz;
+    unsigned int p, i;
+
+    if (out == NULL) fprintf(stderr, "Error: cannot write %s\n", file);
+    else fprintf(out, "ratio\ttarget_ghz\tghz\twatts\titerations_per_s\tgflops\tgbytes_per_s\tgflops_per_watt\n");
+    printf("\nP-state sweep (%u ms per ratio, curve in %s):\n", DWELL, file);
+    printf("  ratio  target [GHz]  achieved [GHz]  power [W]  iterations/s     GFLOPS   GB/s  GFLOPS/W\n");
+    for (p = 0; p < NUM_PSTATES; p++) {
+        iterations = aperf = mperf = 0;
+        rate = flops = bytes = 0.0;
+        for (i = 0; i < mdp->num_threads; i++) {
+            sweepdata_t *pstate = &mdp->threaddata[i].pstatedata[p];
+            double thread_rate;
+
+            if (pstate->tsc == 0) continue;
+            thread_rate = (double)pstate->iterations*(double)cpuinfo->clockrate/(double)pstate->tsc;
+            iterations += pstate->iterations;
+            aperf += pstate->aperf;
+            mperf += pstate->mperf;
+            rate += thread_rate;
+            flops += (double)mdp->threaddata[i].flops*thread_rate;
+            bytes += (double)mdp->threaddata[i].bytes*thread_rate;
         }
-        break;
-    case FUNC_BLD_OPTERON_FMA4_1T:
-        BUFFERSIZE[0] = 16384;
-        BUFFERSIZE[1] = 1048576;
-        BUFFERSIZE[2] = 786432;
-        RAMBUFFERSIZE = 104857600;
-        if (verbose) {
-            printf("\n  Taking FMA4 path optimized for Bulldozer - 1 thread(s) per core");
-            printf("\n  Used buffersizes per thread:\n");
-            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
-            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
+        if (iterations == 0) {
+            printf("  %5u  %12.1f  not reached\n", PSTATES[p], 0.1*PSTATES[p]);
+            continue;
         }
-        break;
-      default:
-        fprintf(stderr, "Internal Error: missing code-path %i!\n",FUNCTION);
-        exit(1);
+        ghz = mperf ? (double)cpuinfo->clockrate*0.000000001*(double)aperf/(double)mperf : 0.0;
+        watts = mdp->threaddata[0].pstatedata[p].wall_tsc ? mdp->threaddata[0].pstatedata[p].joules*(double)cpuinfo->clockrate/(double)mdp->threaddata[0].pstatedata[p].wall_tsc : 0.0;
+        printf("  %5u  %12.1f  %14.3f  %9.2f  %12.2f  %9.2f  %5.2f  %8.3f\n", PSTATES[p], 0.1*PSTATES[p], ghz, watts, rate,
+               flops*0.000000001, bytes*0.000000001, (watts > 0.0) ? flops*0.000000001/watts : 0.0);
+        if (out) fprintf(out, "%u\t%.1f\t%.3f\t%.2f\t%.2f\t%.3f\t%.3f\t%.4f\n", PSTATES[p], 0.1*PSTATES[p], ghz, watts, rate,
+                         flops*0.000000001, bytes*0.000000001, (watts > 0.0) ? flops*0.000000001/watts : 0.0);
     }
-
+    if (out) fclose(out);
 }
 
 int main(int argc, char *argv[])
 {
-    int i,c;
+    int i,c,p,s;
+    int exit_code = EXIT_SUCCESS;
     unsigned long long iterations=0;
 
     #ifdef CUDA
@@ -1008,6 +2371,24 @@ int main(int argc, char *argv[])
         {"timeout",     required_argument,  0, 't'},
         {"load",        required_argument,  0, 'l'},
         {"period",      required_argument,  0, 'p'},
+        {"chunk",       required_argument,  0, OPT_CHUNK},
+        {"chunk-us",    required_argument,  0, OPT_CHUNK_US},
+        {"secondary",   required_argument,  0, OPT_SECONDARY},
+        {"bandwidth",   required_argument,  0, OPT_BANDWIDTH},
+        {"sweep",       optional_argument,  0, OPT_SWEEP},
+        {"data-pattern", required_argument, 0, OPT_DATA_PATTERN},
+        {"auto-function", optional_argument, 0, OPT_AUTO_FUNCTION},
+        {"verify",      optional_argument,  0, OPT_VERIFY},
+        {"coherence",   required_argument,  0, OPT_COHERENCE},
+        {"config",      required_argument,  0, OPT_CONFIG},
+        {"set",         required_argument,  0, OPT_SET},
+        {"rapl-schedule", required_argument, 0, OPT_RAPL_SCHEDULE},
+        {"pstate-sweep", required_argument, 0, OPT_PSTATE_SWEEP},
+        {"dwell",       required_argument,  0, OPT_DWELL},
+        {"target-watts", required_argument, 0, OPT_TARGET_WATTS},
+        {"pstate",      required_argument,  0, OPT_PSTATE},
+        {"campaign",    required_argument,  0, OPT_CAMPAIGN},
+        {"phases",      required_argument,  0, OPT_PHASES},
         {0,             0,                  0,  0 }
     };
 
@@ -1040,7 +2421,11 @@ int main(int argc, char *argv[])
             list_functions();
             return EXIT_SUCCESS;
         case 'i':
-            FUNCTION=get_function((unsigned int)strtol(optarg,NULL,10));
+            if (strchr(optarg,':')) {
+                fsfunction = optarg;
+                break;
+            }
+            FUNCTION=get_function(get_function_id(optarg));
             if (FUNCTION==FUNC_UNKNOWN) return EXIT_FAILURE;
             break;
         case 'r':
@@ -1108,6 +2493,97 @@ int main(int argc, char *argv[])
                 return EXIT_FAILURE;
             }
             break;
+        case OPT_CHUNK:
+            CHUNK = strtoull(optarg,NULL,10);
+            if (errno != 0) {
+                printf("Error: chunk out of range or not a number: %s\n",optarg);
+                return EXIT_FAILURE;
+            }
+            CHUNK_US = 0;
+            break;
+        case OPT_CHUNK_US:
+            CHUNK_US = strtoull(optarg,NULL,10);
+            if ((errno != 0) || (CHUNK_US == 0)) {
+                printf("Error: chunk duration out of range or not a number: %s\n",optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case OPT_SECONDARY:
+            SECONDARY = get_secondary(optarg);
+            if (SECONDARY == FUNC_UNKNOWN) return EXIT_FAILURE;
+            break;
+        case OPT_BANDWIDTH:
+            BANDWIDTH = strtoull(optarg,NULL,10);
+            if (errno != 0) {
+                printf("Error: bandwidth out of range or not a number: %s\n",optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case OPT_SWEEP:
+            if ((optarg == NULL) || (strcmp(optarg, "levels") == 0)) SWEEP = SWEEP_LEVELS;
+            else if (strcmp(optarg, "widths") == 0) SWEEP = SWEEP_WIDTHS;
+            else if (strcmp(optarg, "unroll") == 0) SWEEP = SWEEP_UNROLL;
+            else {
+                printf("Error: unknown sweep: %s, use levels, widths, or unroll\n",optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case OPT_DATA_PATTERN:
+            DATA_PATTERN = get_data_pattern(optarg);
+            if (DATA_PATTERN == FUNC_UNKNOWN) return EXIT_FAILURE;
+            break;
+        case OPT_AUTO_FUNCTION:
+            AUTO_FUNCTION = optarg ? (unsigned int)strtoul(optarg,NULL,10) : AUTO_FUNCTION_MS;
+            if ((errno != 0) || (AUTO_FUNCTION == 0)) {
+                printf("Error: trial duration out of range or not a number: %s\n",optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case OPT_COHERENCE:
+            if (get_coherence(optarg) != EXIT_SUCCESS) return EXIT_FAILURE;
+            break;
+        case OPT_CONFIG:
+            fsconfig_file = optarg;
+            break;
+        case OPT_SET:
+            if (fsconfig_num_sets == MAX_FSCONFIG_SETS) {
+                printf("Error: too many --set options, at most %d\n", MAX_FSCONFIG_SETS);
+                return EXIT_FAILURE;
+            }
+            fsconfig_sets[fsconfig_num_sets++] = optarg;
+            break;
+        case OPT_RAPL_SCHEDULE:
+            fspowercap = optarg;
+            break;
+        case OPT_PSTATE_SWEEP:
+            if (get_pstates(optarg) != EXIT_SUCCESS) return EXIT_FAILURE;
+            break;
+        case OPT_PSTATE:
+            fspstate = optarg;
+            break;
+        case OPT_CAMPAIGN:
+            fscampaign = optarg;
+            break;
+        case OPT_PHASES:
+            fsphases = optarg;
+            break;
+        case OPT_TARGET_WATTS:
+            if (get_target_watts(optarg) != EXIT_SUCCESS) return EXIT_FAILURE;
+            break;
+        case OPT_DWELL:
+            DWELL = (unsigned int)strtoul(optarg,NULL,10);
+            if ((errno != 0) || (DWELL == 0)) {
+                printf("Error: dwell out of range or not a number: %s\n",optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case OPT_VERIFY:
+            VERIFY = optarg ? (unsigned int)strtoul(optarg,NULL,10) : VERIFY_MS;
+            if ((errno != 0) || (VERIFY == 0)) {
+                printf("Error: verification interval out of range or not a number: %s\n",optarg);
+                return EXIT_FAILURE;
+            }
+            break;
         case ':':   // Missing argument
             return EXIT_FAILURE;
         case '?':   // Unknown option
@@ -1119,14 +2595,62 @@ int main(int argc, char *argv[])
         printf("Error: too many parameters!\n");
         return EXIT_FAILURE;
     }
+    if ((fsfunction != NULL) && (SWEEP || VERIFY)) {
+        printf("Error: --sweep and --verify require the same function on all threads, not a CPU list in -i/--function\n");
+        return EXIT_FAILURE;
+    }
+    if ((fspstate != NULL) && NUM_PSTATES) {
+        printf("Error: --pstate and --pstate-sweep cannot be combined\n");
+        return EXIT_FAILURE;
+    }
+    if (SWEEP && NUM_PSTATES) {
+        printf("Error: --sweep and --pstate-sweep cannot be combined\n");
+        return EXIT_FAILURE;
+    }
+    if ((fsphases != NULL) && NUM_PSTATES) {
+        printf("Error: --phases and --pstate-sweep cannot be combined\n");
+        return EXIT_FAILURE;
+    }
+    if ((fscampaign != NULL) && (TIMEOUT || (LOAD != 100) || NUM_PSTATES || (fspowercap != NULL) || (TARGET_WATTS > 0.0))) {
+        printf("Error: the runs of --campaign end after their iterations, it cannot be combined with -t, -l, --pstate-sweep, --rapl-schedule, or --target-watts\n");
+        return EXIT_FAILURE;
+    }
+
+    /* the run configuration is read once, all threads use the validated values */
+    fsconfig_defaults(&FSCONFIG);
+    if (fsconfig_read(&FSCONFIG, fsconfig_file ? fsconfig_file : FSCONFIG_FILE, fsconfig_file != NULL) != EXIT_SUCCESS) return EXIT_FAILURE;
+    for (i = 0; i < (int)fsconfig_num_sets; i++) {
+        if (fsconfig_set(&FSCONFIG, fsconfig_sets[i], "--set") != EXIT_SUCCESS) return EXIT_FAILURE;
+    }
+    if (fsconfig_validate(&FSCONFIG) != EXIT_SUCCESS) return EXIT_FAILURE;
+    if (NUM_PSTATES && (FSCONFIG.partition_time > 0.0)) {
+        printf("Error: --pstate-sweep keeps the threads in sync with the samples of the partitions, partition_time has to be 0\n");
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "run configuration:\n");
+    fsconfig_print(stderr, &FSCONFIG);
+    if ((fspowercap != NULL) && (powercap_read(&POWERCAP, fspowercap) != EXIT_SUCCESS)) return EXIT_FAILURE;
+    if ((fscampaign != NULL) && (campaign_read(&CAMPAIGN, fscampaign, &FSCONFIG) != EXIT_SUCCESS)) return EXIT_FAILURE;
+    if ((fsphases != NULL) && (phases_read(&PHASES, fsphases, &SECONDARY) != EXIT_SUCCESS)) return EXIT_FAILURE;
 
     LOAD = ( PERIOD * LOAD ) / 100;
-    if ((LOAD == PERIOD) || (LOAD == 0)) PERIOD = 0;    // disable interupts for 100% and 0% load case
+    if (TARGET_WATTS > 0.0) {
+        /* the controller needs the periods, -l only sets the share it starts from */
+        if (PERIOD == 0) {
+            printf("Error: --target-watts requires a period (-p) greater than 0\n");
+            return EXIT_FAILURE;
+        }
+    }
+    else if ((LOAD == PERIOD) || (LOAD == 0)) PERIOD = 0;    // disable interupts for 100% and 0% load case
     if (LOAD == 0) LOADVAR = LOAD_LOW;                  // use low load routine
     watchdog_arg.timeout = (unsigned int) TIMEOUT;
     watchdog_arg.period  = (useconds_t) PERIOD;
     watchdog_arg.load    = (useconds_t) LOAD;
     watchdog_arg.loadvar = &LOADVAR;
+    watchdog_arg.target_watts = TARGET_WATTS;
+    watchdog_arg.kp = TARGET_GAINS[0];
+    watchdog_arg.ki = TARGET_GAINS[1];
+    watchdog_arg.kd = TARGET_GAINS[2];
 
     if(verbose){
        show_version();
@@ -1146,21 +2670,45 @@ int main(int argc, char *argv[])
     #endif
 
     evaluate_environment();
+    watchdog_arg.packages = (cpuinfo->num_packages < MAX_PACKAGES) ? cpuinfo->num_packages : MAX_PACKAGES;
+    if (watchdog_arg.packages == 0) watchdog_arg.packages = 1;
+    if (fspowercap != NULL) mdp->powercap = &POWERCAP;
+    memcpy(mdp->pstates, PSTATES, sizeof(PSTATES));
+    mdp->num_pstates = NUM_PSTATES;
+    mdp->dwell_tsc = cpuinfo->clockrate / 1000 * DWELL;
+    mdp->pstate_current = 0;
+    mdp->run_dir = "";
+    if (fsphases != NULL) mdp->phases = &PHASES;
     init();
 
-    //start worker threads
-    _work(mdp, &LOADVAR);
+    if (fscampaign != NULL) {
+        /* the runs start the worker threads one after the other, the load is not switched */
+        if (campaign_execute(&CAMPAIGN, mdp, &LOADVAR, thread_pstate) != EXIT_SUCCESS) {
+            for(i = 0; i < mdp->num_threads; i++) pthread_join(threads[i], NULL);
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        //start worker threads
+        _work(mdp, &LOADVAR);
 
-    //start watchdog
-    watchdog_arg.pid = getpid();
-    watchdog_timer(&watchdog_arg);
+        //start watchdog
+        watchdog_arg.pid = getpid();
+        watchdog_timer(&watchdog_arg);
+    }
 
     /* wait for threads after watchdog has requested termination */
     for(i = 0; i < mdp->num_threads; i++) pthread_join(threads[i], NULL);
 
+    /* the control thread is still running if the run was ended by the timeout */
+    if (fspowercap != NULL) {
+        powercap_stop(&POWERCAP);
+        powercap_report(stdout, &POWERCAP, POWERCAP_TRACE);
+    }
+
     if (verbose == 2){
        unsigned long long start_tsc,stop_tsc;
-       double runtime;
+       double runtime, flops=0.0, bytes=0.0;
   
        printf("\nperformance report:\n\n");
 
@@ -1169,6 +2717,9 @@ int main(int argc, char *argv[])
        for(i = 0; i < mdp->num_threads; i++){
           printf("Thread %i: %llu iterations, tsc_delta: %llu\n",i,mdp->threaddata[i].iterations, mdp->threaddata[i].stop_tsc - mdp->threaddata[i].start_tsc );
           iterations+=mdp->threaddata[i].iterations;
+          /* the threads can run different functions (-i CPULIST:ID,...) */
+          flops+=(double)mdp->threaddata[i].flops*(double)mdp->threaddata[i].iterations;
+          bytes+=(double)mdp->threaddata[i].bytes*(double)mdp->threaddata[i].iterations;
           if (start_tsc > mdp->threaddata[i].start_tsc) start_tsc = mdp->threaddata[i].start_tsc;
           if (stop_tsc < mdp->threaddata[i].stop_tsc) stop_tsc = mdp->threaddata[i].stop_tsc;
        }
@@ -1176,8 +2727,77 @@ int main(int argc, char *argv[])
        runtime=(double)(stop_tsc - start_tsc) / (double)cpuinfo->clockrate;
        printf("runtime: %.2f seconds (%llu cycles)\n\n",runtime, stop_tsc - start_tsc);
 
-       printf("estimated floating point performance: %.2f GFLOPS\n", (double)mdp->threaddata[0].flops*0.000000001*(double)iterations/runtime);
-       printf("estimated memory bandwidth*: %.2f GB/s\n", (double)mdp->threaddata[0].bytes*0.000000001*(double)iterations/runtime);
+       printf("estimated floating point performance: %.2f GFLOPS\n", flops*0.000000001/runtime);
+       printf("estimated memory bandwidth*: %.2f GB/s\n", bytes*0.000000001/runtime);
+
+       /* per phase rates use the cycles each thread spent in that phase */
+       for(p = 0; p < NUM_PHASES; p++){
+          unsigned long long phase_iterations=0;
+          double rate=0.0, max_gflops=0.0, gflops[MAX_SWEEP], thread_rate, transfers=0.0;
+
+          flops=0.0;
+          bytes=0.0;
+          for(i = 0; i < mdp->num_threads; i++){
+             if (mdp->threaddata[i].phase_tsc[p] == 0) continue;
+             phase_iterations+=mdp->threaddata[i].phase_iterations[p];
+             thread_rate=(double)mdp->threaddata[i].phase_iterations[p]*(double)cpuinfo->clockrate/(double)mdp->threaddata[i].phase_tsc[p];
+             rate+=thread_rate;
+             flops+=(double)mdp->threaddata[i].flops*thread_rate;
+             bytes+=(double)mdp->threaddata[i].bytes*thread_rate;
+             if (IS_COHERENCE_FUNCTION(mdp->threaddata[i].FUNCTION)) transfers+=(double)COH_TRANSFERS*thread_rate;
+          }
+          if (phase_iterations == 0) continue;
+
+          if (p == PHASE_PAYLOAD){
+             printf("\nFIRESTARTER payload: %llu iterations, %.2f iterations/s\n",phase_iterations,rate);
+             printf("  estimated floating point performance: %.2f GFLOPS\n", flops*0.000000001);
+             printf("  estimated memory bandwidth*: %.2f GB/s\n", bytes*0.000000001);
+             if (transfers > 0.0) printf("  cache line transfers between the threads of the coherence groups: %.2f M/s (%s placement)\n", transfers*0.000001, coherence_placements[COHERENCE]);
+
+             /* --sweep: rates, frequency, and package power of each variant */
+             for(s = 0; s < mdp->threaddata[0].num_sweep; s++){
+                sweepdata_t *sweep = &mdp->threaddata[0].sweepdata[s];
+                phase_iterations=0;
+                rate=0.0;
+                for(i = 0; i < mdp->num_threads; i++){
+                   if (mdp->threaddata[i].sweepdata[s].tsc == 0) continue;
+                   phase_iterations+=mdp->threaddata[i].sweepdata[s].iterations;
+                   rate+=(double)mdp->threaddata[i].sweepdata[s].iterations*(double)cpuinfo->clockrate/(double)mdp->threaddata[i].sweepdata[s].tsc;
+                }
+                gflops[s] = (double)sweep->flops*0.000000001*rate;
+                printf("  %-10s (function %i): %llu iterations, %.2f iterations/s, %.2f GFLOPS, %.2f GB/s",
+                       get_sweep_label(mdp->threaddata[0].sweep[s]),mdp->threaddata[0].sweep[s],phase_iterations,rate,
+                       gflops[s],(double)sweep->bytes*0.000000001*rate);
+                if (sweep->mperf) printf(", %.3f GHz", (double)cpuinfo->clockrate*0.000000001*(double)sweep->aperf/(double)sweep->mperf);
+                if (sweep->wall_tsc) printf(", %.2f W", sweep->joules*(double)cpuinfo->clockrate/(double)sweep->wall_tsc);
+                printf("\n");
+                if (gflops[s] > max_gflops) max_gflops = gflops[s];
+             }
+
+             /* --sweep=unroll: smallest loop that reaches the FLOPS rate of the largest ones */
+             if ((SWEEP == SWEEP_UNROLL) && (max_gflops > 0.0)){
+                for(s = 0; gflops[s] < SWEEP_UNROLL_SATURATION * max_gflops; s++);
+                printf("  smallest unroll within %.0f%% of the highest FLOPS rate: %s (function %i)\n",
+                       100.0*(1.0-SWEEP_UNROLL_SATURATION),get_sweep_label(mdp->threaddata[0].sweep[s]),mdp->threaddata[0].sweep[s]);
+             }
+          }
+          else{
+             /* --phases can run several secondary workloads, each one is reported with its own rate */
+             for(s = 1; s < NUM_SECONDARY; s++){
+                phase_iterations=0;
+                rate=0.0;
+                for(i = 0; i < mdp->num_threads; i++){
+                   if (mdp->threaddata[i].secondary_tsc[s] == 0) continue;
+                   phase_iterations+=mdp->threaddata[i].secondary_iterations[s];
+                   rate+=(double)mdp->threaddata[i].secondary_iterations[s]*(double)cpuinfo->clockrate/(double)mdp->threaddata[i].secondary_tsc[s];
+                }
+                if (phase_iterations == 0) continue;
+                printf("\nsecondary workload %s: %llu iterations, %.2f iterations/s\n",secondary_workloads[s].name,phase_iterations,rate);
+                if (secondary_workloads[s].flops) printf("  floating point performance: %.2f GFLOPS\n", (double)secondary_workloads[s].flops*0.000000001*rate);
+                if (secondary_workloads[s].bytes) printf("  memory bandwidth: %.2f GB/s\n", (double)secondary_workloads[s].bytes*0.000000001*rate);
+             }
+          }
+       }
        printf("\n* this estimate is highly unreliable if --function is used in order to select\n");
        printf("  a function that is not optimized for your architecture, or if FIRESTARTER is\n");
        printf("  executed on an unsupported architecture!\n");
@@ -1185,6 +2805,28 @@ int main(int argc, char *argv[])
        printf("\n");
     }
 
+    /* --pstate-sweep: the curve is reported regardless of -q */
+    if (NUM_PSTATES) pstate_report(PSTATE_CURVE);
+
+    /* --verify: summary and failing CPUs are reported regardless of -q */
+    if (VERIFY){
+       unsigned long long checks=0, errors=0, cycles=0, tsc=0;
+
+       for(i = 0; i < mdp->num_threads; i++){
+          checks+=mdp->threaddata[i].verify_checks;
+          errors+=mdp->threaddata[i].verify_errors;
+          cycles+=mdp->threaddata[i].verify_cycles;
+          tsc+=mdp->threaddata[i].stop_tsc - mdp->threaddata[i].start_tsc;
+       }
+       printf("\nverification of the payload results: %llu checks, %llu failed, %.2f%% of the runtime\n",
+              checks, errors, tsc ? 100.0*(double)cycles/(double)tsc : 0.0);
+       for(i = 0; i < mdp->num_threads; i++){
+          if (mdp->threaddata[i].verify_errors)
+             printf("  CPU %u: %llu of %llu checks failed\n",mdp->threaddata[i].cpu_id,mdp->threaddata[i].verify_errors,mdp->threaddata[i].verify_checks);
+       }
+       if (errors) exit_code = EXIT_FAILURE;
+    }
+
 #ifndef MCK
 	finalize_msr();
 #endif
@@ -1193,6 +2835,6 @@ int main(int argc, char *argv[])
     free(structpointer);
     #endif
 
-    return EXIT_SUCCESS;
+    return exit_code;
 }
 
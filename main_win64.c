@@ -185,12 +185,18 @@ static DWORD WINAPI WorkerThread(void* threadParams)
   void * p;
 
   data->iterations=0;
+  data->chunk=0;
+  data->shift_seed=DEFAULT_SHIFT_SEED;
   data->start_tsc=timestamp();
 
   switch (data->FUNCTION) {
     case FUNC_KNL_XEONPHI_AVX512_4T:
       p = _mm_malloc(3351552*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 8192;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 59069781;
+      data->buffersize[3] = 6553600;
       init_knl_xeonphi_avx512_4t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_knl_xeonphi_avx512_4t(data);
@@ -200,6 +206,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_SKL_COREI_FMA_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 1572864;
+      data->buffersize[3] = 104857600;
       init_skl_corei_fma_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_skl_corei_fma_1t(data);
@@ -209,6 +219,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_SKL_COREI_FMA_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 786432;
+      data->buffersize[3] = 52428800;
       init_skl_corei_fma_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_skl_corei_fma_2t(data);
@@ -218,6 +232,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_HSW_COREI_FMA_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 1572864;
+      data->buffersize[3] = 104857600;
       init_hsw_corei_fma_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_hsw_corei_fma_1t(data);
@@ -227,6 +245,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_HSW_COREI_FMA_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 786432;
+      data->buffersize[3] = 52428800;
       init_hsw_corei_fma_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_hsw_corei_fma_2t(data);
@@ -236,6 +258,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_HSW_XEONEP_FMA_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 2621440;
+      data->buffersize[3] = 104857600;
       init_hsw_xeonep_fma_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_hsw_xeonep_fma_1t(data);
@@ -245,6 +271,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_HSW_XEONEP_FMA_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 1310720;
+      data->buffersize[3] = 52428800;
       init_hsw_xeonep_fma_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_hsw_xeonep_fma_2t(data);
@@ -254,6 +284,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_SNB_COREI_AVX_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 1572864;
+      data->buffersize[3] = 104857600;
       init_snb_corei_avx_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_snb_corei_avx_1t(data);
@@ -263,6 +297,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_SNB_COREI_AVX_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 786432;
+      data->buffersize[3] = 52428800;
       init_snb_corei_avx_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_snb_corei_avx_2t(data);
@@ -272,6 +310,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_SNB_XEONEP_AVX_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 2621440;
+      data->buffersize[3] = 104857600;
       init_snb_xeonep_avx_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_snb_xeonep_avx_1t(data);
@@ -281,6 +323,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_SNB_XEONEP_AVX_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 1310720;
+      data->buffersize[3] = 52428800;
       init_snb_xeonep_avx_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_snb_xeonep_avx_2t(data);
@@ -290,6 +336,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_NHM_COREI_SSE2_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 1572864;
+      data->buffersize[3] = 104857600;
       init_nhm_corei_sse2_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_nhm_corei_sse2_1t(data);
@@ -299,6 +349,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_NHM_COREI_SSE2_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 786432;
+      data->buffersize[3] = 52428800;
       init_nhm_corei_sse2_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_nhm_corei_sse2_2t(data);
@@ -308,6 +362,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_NHM_XEONEP_SSE2_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 32768;
+      data->buffersize[1] = 262144;
+      data->buffersize[2] = 2097152;
+      data->buffersize[3] = 104857600;
       init_nhm_xeonep_sse2_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_nhm_xeonep_sse2_1t(data);
@@ -317,6 +375,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_NHM_XEONEP_SSE2_2T:
       p = _mm_malloc(6703104*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 131072;
+      data->buffersize[2] = 1048576;
+      data->buffersize[3] = 52428800;
       init_nhm_xeonep_sse2_2t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_nhm_xeonep_sse2_2t(data);
@@ -326,6 +388,10 @@ static DWORD WINAPI WorkerThread(void* threadParams)
     case FUNC_BLD_OPTERON_FMA4_1T:
       p =  _mm_malloc(13406208*8,4096);
       data->addrMem = (unsigned long long) p;
+      data->buffersize[0] = 16384;
+      data->buffersize[1] = 1048576;
+      data->buffersize[2] = 786432;
+      data->buffersize[3] = 104857600;
       init_bld_opteron_fma4_1t(data);
       while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){
         asm_work_bld_opteron_fma4_1t(data);
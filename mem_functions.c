@@ -0,0 +1,220 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#include "work.h"
+#include <emmintrin.h>
+
+/*
+ * memory bandwidth payloads
+ * the buffer holds 3 arrays of MEM_ARRAYSIZE bytes, one iteration processes
+ * MEM_BLOCKSIZE bytes of each array that is used, blocks are visited in
+ * sequential order (derived from the iteration counter) so that each stream
+ * leaves the caches before it wraps around
+ */
+#define MEM_BLOCKS       (MEM_ARRAYSIZE / MEM_BLOCKSIZE)
+#define MEM_BLOCK_DOUBLE (MEM_BLOCKSIZE / sizeof(double))
+
+#define MEM_BLOCK_ADDR(threaddata, array) \
+    ((double *)((threaddata)->addrMem + (array) * MEM_ARRAYSIZE + ((threaddata)->iterations % MEM_BLOCKS) * MEM_BLOCKSIZE))
+
+/*
+ * fill the arrays and derive the number of cycles per iteration from the target bandwidth (MB/s)
+ */
+static int init_mem(threaddata_t* threaddata, unsigned long long flops, unsigned long long bytes)
+{
+    unsigned long long addrMem = threaddata->addrMem;
+    unsigned long long i;
+
+    for (i = 0; i < 3 * MEM_ARRAYSIZE; i += 8) *((double*)(addrMem+i)) = 0.25 + (double)(i % INIT_BLOCKSIZE) * 0.27948995982e-4;
+
+    threaddata->flops = flops;
+    threaddata->bytes = bytes;
+    threaddata->pace_tsc = 0;
+    if (threaddata->bandwidth) {
+        threaddata->pace_tsc = threaddata->data->cpuinfo->clockrate * bytes / (threaddata->bandwidth * 1000000ULL);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * rdtsc without the feature check of timestamp(), which executes cpuid
+ */
+static inline unsigned long long mem_rdtsc()
+{
+    unsigned long long low, high;
+
+    __asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
+    return (high << 32) | low;
+}
+
+/*
+ * wait until the next iteration is due if a target bandwidth is set
+ */
+static inline void mem_pace(threaddata_t* threaddata, unsigned long long *next)
+{
+    if (threaddata->pace_tsc == 0) return;
+    *next += threaddata->pace_tsc;
+    while (mem_rdtsc() < *next) __asm__ __volatile__("pause;");
+}
+
+int init_mem_ntstore_sse2(threaddata_t* threaddata)
+{
+    return init_mem(threaddata, 0, MEM_BLOCKSIZE);
+}
+
+int init_mem_read_sse2(threaddata_t* threaddata)
+{
+    return init_mem(threaddata, MEM_BLOCK_DOUBLE, MEM_BLOCKSIZE);
+}
+
+int init_mem_copy_sse2(threaddata_t* threaddata)
+{
+    return init_mem(threaddata, 0, 2 * MEM_BLOCKSIZE);
+}
+
+int init_mem_triad_sse2(threaddata_t* threaddata)
+{
+    return init_mem(threaddata, 2 * MEM_BLOCK_DOUBLE, 3 * MEM_BLOCKSIZE);
+}
+
+/*
+ * the work functions below follow the convention of the generated ones:
+ * run threaddata->chunk iterations (0: until the load level changes) and
+ * accumulate them in threaddata->iterations
+ */
+
+/**
+ * non-temporal streaming stores: a[i] = s
+ */
+int asm_work_mem_ntstore_sse2(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long next = mem_rdtsc();
+    __m128d s = _mm_set1_pd(0.25);
+    double *a;
+    unsigned int i;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        a = MEM_BLOCK_ADDR(threaddata, 0);
+        for (i = 0; i < MEM_BLOCK_DOUBLE; i += 8) {
+            _mm_stream_pd(a + i, s);
+            _mm_stream_pd(a + i + 2, s);
+            _mm_stream_pd(a + i + 4, s);
+            _mm_stream_pd(a + i + 6, s);
+        }
+        threaddata->iterations++;
+        mem_pace(threaddata, &next);
+    } while (--chunk && (*high == LOAD_HIGH));
+    _mm_sfence();
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * read-only stream: s += a[i]
+ */
+int asm_work_mem_read_sse2(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long next = mem_rdtsc();
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    double *a;
+    unsigned int i;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        a = MEM_BLOCK_ADDR(threaddata, 0);
+        for (i = 0; i < MEM_BLOCK_DOUBLE; i += 8) {
+            s0 = _mm_add_pd(s0, _mm_load_pd(a + i));
+            s1 = _mm_add_pd(s1, _mm_load_pd(a + i + 2));
+            s2 = _mm_add_pd(s2, _mm_load_pd(a + i + 4));
+            s3 = _mm_add_pd(s3, _mm_load_pd(a + i + 6));
+        }
+        threaddata->iterations++;
+        mem_pace(threaddata, &next);
+    } while (--chunk && (*high == LOAD_HIGH));
+    /* keep the sums alive, otherwise the loads are removed */
+    __asm__ __volatile__("" : : "x" (s0), "x" (s1), "x" (s2), "x" (s3));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * copy with non-temporal stores: a[i] = b[i]
+ */
+int asm_work_mem_copy_sse2(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long next = mem_rdtsc();
+    double *a, *b;
+    unsigned int i;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        a = MEM_BLOCK_ADDR(threaddata, 0);
+        b = MEM_BLOCK_ADDR(threaddata, 1);
+        for (i = 0; i < MEM_BLOCK_DOUBLE; i += 8) {
+            _mm_stream_pd(a + i, _mm_load_pd(b + i));
+            _mm_stream_pd(a + i + 2, _mm_load_pd(b + i + 2));
+            _mm_stream_pd(a + i + 4, _mm_load_pd(b + i + 4));
+            _mm_stream_pd(a + i + 6, _mm_load_pd(b + i + 6));
+        }
+        threaddata->iterations++;
+        mem_pace(threaddata, &next);
+    } while (--chunk && (*high == LOAD_HIGH));
+    _mm_sfence();
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * triad with non-temporal stores: a[i] = b[i] + s * c[i]
+ */
+int asm_work_mem_triad_sse2(threaddata_t* threaddata)
+{
+    volatile unsigned long long *high = (volatile unsigned long long *)threaddata->addrHigh;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long next = mem_rdtsc();
+    __m128d s = _mm_set1_pd(0.5);
+    double *a, *b, *c;
+    unsigned int i;
+
+    if (*high == 0) return EXIT_SUCCESS;
+    do {
+        a = MEM_BLOCK_ADDR(threaddata, 0);
+        b = MEM_BLOCK_ADDR(threaddata, 1);
+        c = MEM_BLOCK_ADDR(threaddata, 2);
+        for (i = 0; i < MEM_BLOCK_DOUBLE; i += 4) {
+            _mm_stream_pd(a + i, _mm_add_pd(_mm_load_pd(b + i), _mm_mul_pd(s, _mm_load_pd(c + i))));
+            _mm_stream_pd(a + i + 2, _mm_add_pd(_mm_load_pd(b + i + 2), _mm_mul_pd(s, _mm_load_pd(c + i + 2))));
+        }
+        threaddata->iterations++;
+        mem_pace(threaddata, &next);
+    } while (--chunk && (*high == LOAD_HIGH));
+    _mm_sfence();
+
+    return EXIT_SUCCESS;
+}
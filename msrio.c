@@ -0,0 +1,74 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <unistd.h>
+#include "msrio.h"
+
+#ifndef MCK
+#include "msr_core.h"
+#endif
+
+#define READ 312
+#define WRITE 313
+
+int msrio_read(unsigned int cpu, uint64_t msr, uint64_t *value)
+{
+#ifdef MCK
+    return (int) syscall(READ, msr, value);
+#endif
+#ifndef MCK
+    return read_msr_by_coord(0, cpu, 0, msr, value);
+#endif
+}
+
+int msrio_write(unsigned int cpu, uint64_t msr, uint64_t value)
+{
+#ifdef MCK
+    return (int) syscall(WRITE, msr, &value);
+#endif
+#ifndef MCK
+    return write_msr_by_coord(0, cpu, 0, msr, value);
+#endif
+}
+
+int msrio_read_package(unsigned int package, uint64_t msr, uint64_t *value)
+{
+#ifdef MCK
+    if (package != 0) return -1;
+    return (int) syscall(READ, msr, value);
+#endif
+#ifndef MCK
+    return read_msr_by_coord(package, 0, 0, msr, value);
+#endif
+}
+
+int msrio_write_package(unsigned int package, uint64_t msr, uint64_t value)
+{
+#ifdef MCK
+    if (package != 0) return -1;
+    return (int) syscall(WRITE, msr, &value);
+#endif
+#ifndef MCK
+    return write_msr_by_coord(package, 0, 0, msr, value);
+#endif
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__MSRIO_H
+#define __FIRESTARTER__MSRIO_H
+
+#include <stdint.h>
+
+/*
+ * access to the MSRs of a CPU: McKernel provides a system call for the MSRs of the calling CPU (cpu is ignored),
+ * the other builds use libmsr, return 0 on success
+ */
+extern int msrio_read(unsigned int cpu, uint64_t msr, uint64_t *value);
+extern int msrio_write(unsigned int cpu, uint64_t msr, uint64_t value);
+
+/*
+ * access to a package MSR through the first CPU of package, McKernel can only access the package of the
+ * calling CPU and fails for the other packages
+ */
+extern int msrio_read_package(unsigned int package, uint64_t msr, uint64_t *value);
+extern int msrio_write_package(unsigned int package, uint64_t msr, uint64_t value);
+
+#endif
+
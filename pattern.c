@@ -0,0 +1,151 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <emmintrin.h>
+#include "pattern.h"
+#include "work.h"
+
+const char *data_patterns[NUM_PATTERNS] = {
+    "default",
+    "zeros",
+    "ones",
+    "alternate",
+    "random",
+    "toggle",
+};
+
+int get_data_pattern(const char *name)
+{
+    int i;
+
+    for (i = 0; i < NUM_PATTERNS; i++) {
+        if (strcmp(name, data_patterns[i]) == 0) return i;
+    }
+    fprintf(stderr, "\nError: unknown data pattern: %s, valid values:", name);
+    for (i = 0; i < NUM_PATTERNS; i++) fprintf(stderr, " %s", data_patterns[i]);
+    fprintf(stderr, "\n\n");
+
+    return FUNC_UNKNOWN;
+}
+
+/*
+ * splitmix64, used to derive independent xorshift states from the thread ID
+ */
+static unsigned long long mix(unsigned long long x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+unsigned int data_pattern_shift_seed(int pattern, unsigned int thread_id)
+{
+    switch (pattern) {
+        case PATTERN_ZEROS:
+            return 0;
+        case PATTERN_ONES:
+            return 0xFFFFFFFF;
+        case PATTERN_RANDOM:
+            return (unsigned int)mix(thread_id);
+        default: /* shifting alternating bits toggles all of them */
+            return DEFAULT_SHIFT_SEED;
+    }
+}
+
+/*
+ * the single precision and integer payloads use 32 bit elements
+ */
+static int single_elements(int func)
+{
+    switch (func) {
+        case FUNC_SKL_COREI_SP_FMA_1T:
+        case FUNC_SKL_COREI_SP_FMA_2T:
+        case FUNC_SKL_COREI_INT16_FMA_1T:
+        case FUNC_SKL_COREI_INT16_FMA_2T:
+        case FUNC_SKL_COREI_INT8_FMA_1T:
+        case FUNC_SKL_COREI_INT8_FMA_2T:
+        case FUNC_SKL_COREI_BF16_FMA_1T:
+        case FUNC_SKL_COREI_BF16_FMA_2T:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+void fill_data_pattern(threaddata_t *threaddata)
+{
+    int sp = single_elements(threaddata->FUNCTION);
+    unsigned long long size = threaddata->buffersizeMem & ~63ULL;
+    unsigned long long one = sp ? 0x3F8000003F800000ULL : 0x3FF0000000000000ULL;
+    unsigned long long mantissa = sp ? 0x007FFFFF007FFFFFULL : 0x000FFFFFFFFFFFFFULL;
+    unsigned long long sign = sp ? 0x8000000080000000ULL : 0x8000000000000000ULL;
+    __m128i keep = _mm_set1_epi64x(sign | mantissa), set = _mm_set1_epi64x(one);
+    __m128i v[4], s[4];
+    char *p = threaddata->bufferMem;
+    unsigned long long i;
+    int j;
+
+    /* v[0..1] are written to the first, v[2..3] to the second 32 bytes of each cache line */
+    switch (threaddata->data_pattern) {
+        case PATTERN_ZEROS:
+            v[0] = _mm_setzero_si128();
+            break;
+        case PATTERN_ONES:
+            v[0] = _mm_set1_epi64x(one | mantissa);
+            break;
+        case PATTERN_ALTERNATE:
+            v[0] = sp ? _mm_set1_epi64x(0x55555555AAAAAAAAULL) : _mm_set_epi64x(0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL);
+            break;
+        case PATTERN_TOGGLE: /* a value in [1,2), its complement is negative and finite as well */
+            v[0] = _mm_set1_epi64x(one | (mantissa & 0x5555555555555555ULL));
+            break;
+        case PATTERN_RANDOM:
+            for (j = 0; j < 4; j++) s[j] = _mm_set_epi64x(mix(4 * threaddata->thread_id + j), mix(~(4ULL * threaddata->thread_id + j)));
+            v[0] = set;
+            break;
+        default:
+            return;
+    }
+    v[1] = v[0];
+    v[2] = v[3] = (threaddata->data_pattern == PATTERN_TOGGLE) ? _mm_xor_si128(v[0], _mm_set1_epi64x(-1)) : v[0];
+
+    for (i = 0; i < size; i += 64) {
+        if (threaddata->data_pattern == PATTERN_RANDOM) {
+            /* xorshift64 in 8 independent lanes, the exponent is fixed to avoid denormals, infinities and NaNs */
+            for (j = 0; j < 4; j++) {
+                s[j] = _mm_xor_si128(s[j], _mm_slli_epi64(s[j], 13));
+                s[j] = _mm_xor_si128(s[j], _mm_srli_epi64(s[j], 7));
+                s[j] = _mm_xor_si128(s[j], _mm_slli_epi64(s[j], 17));
+                v[j] = _mm_or_si128(_mm_and_si128(s[j], keep), set);
+            }
+        }
+        _mm_store_si128((__m128i *)(p + i), v[0]);
+        _mm_store_si128((__m128i *)(p + i + 16), v[1]);
+        _mm_store_si128((__m128i *)(p + i + 32), v[2]);
+        _mm_store_si128((__m128i *)(p + i + 48), v[3]);
+    }
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__PATTERN_H
+#define __FIRESTARTER__PATTERN_H
+
+#include "firestarter_global.h"
+
+/*
+ * operand data patterns of the payload (--data-pattern), applied to the buffer
+ * and thereby to the SIMD registers that are loaded from it in the asm prologue
+ */
+#define PATTERN_DEFAULT        0 /* initialization of the init_* functions */
+#define PATTERN_ZEROS          1 /* all bits 0 */
+#define PATTERN_ONES           2 /* 1.999..., exponent of 1.0 and all mantissa bits set */
+#define PATTERN_ALTERNATE      3 /* neighboring elements 0xAA... and 0x55... */
+#define PATTERN_RANDOM         4 /* random sign and mantissa, exponent of 1.0 */
+#define PATTERN_TOGGLE         5 /* 32 byte blocks alternate between a value and its complement */
+#define NUM_PATTERNS           6 /* highest ID + 1 */
+
+extern const char *data_patterns[NUM_PATTERNS];
+
+/*
+ * returns the ID of the data pattern with the given name, FUNC_UNKNOWN if there is none
+ */
+extern int get_data_pattern(const char *name);
+
+/*
+ * returns the seed of the shift registers for the given pattern
+ */
+extern unsigned int data_pattern_shift_seed(int pattern, unsigned int thread_id);
+
+/*
+ * overwrites the buffer of the thread with threaddata->data_pattern,
+ * the element size (float or double) is derived from threaddata->FUNCTION
+ */
+extern void fill_data_pattern(threaddata_t *threaddata);
+
+#endif
+
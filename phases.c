@@ -0,0 +1,431 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+
+#include "firestarter_global.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "phases.h"
+#include "secondary.h"
+
+/*
+ * DURATION of a step: samples, a time with unit, or * (until the end of the run)
+ */
+static int parse_duration(phase_step_t *step, const char *arg)
+{
+    char *end;
+    double value;
+
+    if (strcmp(arg, "*") == 0) return EXIT_SUCCESS;
+    value = strtod(arg, &end);
+    if ((end == arg) || (value <= 0.0)) return EXIT_FAILURE;
+    if (*end == '\0') {
+        if (value != (double) (unsigned long) value) return EXIT_FAILURE;
+        step->samples = (unsigned long) value;
+    }
+    else if (strcmp(end, "s") == 0) step->seconds = value;
+    else if (strcmp(end, "ms") == 0) step->seconds = value / 1000.0;
+    else if (strcmp(end, "us") == 0) step->seconds = value / 1000000.0;
+    else return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * KEY=VALUE options of a step
+ */
+static int parse_option(phase_step_t *step, char *option, const char *where)
+{
+    char *value = strchr(option, '='), *end;
+
+    if (value == NULL) {
+        fprintf(stderr, "Error: %s: expected KEY=VALUE, not: %s\n", where, option);
+        return EXIT_FAILURE;
+    }
+    *value++ = '\0';
+    if (strcmp(option, "pstate") == 0) {
+        step->pstate = strtoul(value, &end, 0);
+        if ((end == value) || (*end != '\0') || (step->pstate == 0) || (step->pstate > 0xFFFF)) {
+            fprintf(stderr, "Error: %s: pstate has to be between 1 and 0xFFFF: %s\n", where, value);
+            return EXIT_FAILURE;
+        }
+    }
+    else if (strcmp(option, "cap") == 0) {
+        step->cap = strtod(value, &end);
+        if ((end == value) || ((*end != '\0') && strcmp(end, "W")) || (step->cap <= 0.0) || (step->cap > 4095.0)) {
+            fprintf(stderr, "Error: %s: cap has to be between 0 and 4095 W: %s\n", where, value);
+            return EXIT_FAILURE;
+        }
+    }
+    else if (strcmp(option, "cores") == 0) {
+        step->cores = strdup(value);
+        if (step->cores == NULL) return EXIT_FAILURE;
+    }
+    else {
+        fprintf(stderr, "Error: %s: unknown option %s, use pstate, cap, or cores\n", where, option);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * workload of a step, -1 if the name is unknown
+ */
+static int parse_workload(const char *name, int secondary)
+{
+    int i;
+
+    if (strcmp(name, "idle") == 0) return PHASE_IDLE;
+    if (strcmp(name, "secondary") == 0) return secondary;
+    for (i = 0; i < NUM_SECONDARY; i++) {
+        if (strcmp(name, secondary_workloads[i].name) == 0) return i;
+    }
+
+    return -1;
+}
+
+static int buffered(int workload)
+{
+    return (workload == SEC_PTRCHASE) || (workload == SEC_STREAM);
+}
+
+int phases_read(phase_seq_t *seq, const char *file, int *secondary)
+{
+    FILE *stream = fopen(file, "r");
+    char line[1024], where[300], *word, *comment, *save, *end;
+    unsigned int lineno = 0, max_steps = 0, depth = 0, open[PHASE_MAX_DEPTH], runs = 0, runs_open[PHASE_MAX_DEPTH];
+    int workload, needs_buffer = buffered(*secondary) ? *secondary : -1;
+    phase_step_t step;
+
+    memset(seq, 0, sizeof(phase_seq_t));
+    if (stream == NULL) {
+        fprintf(stderr, "Error: cannot open the phase sequence %s\n", file);
+        return EXIT_FAILURE;
+    }
+    seq->uniform = 1;
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        lineno++;
+        comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        word = strtok_r(line, " \t\r\n", &save);
+        if (word == NULL) continue;
+        snprintf(where, sizeof(where), "%s:%u", file, lineno);
+        memset(&step, 0, sizeof(step));
+        step.line = lineno;
+        if (strcmp(word, "repeat") == 0) {
+            step.type = PHASE_STEP_REPEAT;
+            word = strtok_r(NULL, " \t\r\n", &save);
+            if (word != NULL) {
+                step.count = (unsigned int) strtoul(word, &end, 10);
+                if ((*end != '\0') || (step.count == 0)) {
+                    fprintf(stderr, "Error: %s: repeat needs a count of at least 1 or none (forever): %s\n", where, word);
+                    goto error;
+                }
+            }
+            if (depth == PHASE_MAX_DEPTH) {
+                fprintf(stderr, "Error: %s: more than %d nested repeat blocks\n", where, PHASE_MAX_DEPTH);
+                goto error;
+            }
+            open[depth] = seq->num_steps;
+            runs_open[depth++] = runs;
+        }
+        else if (strcmp(word, "end") == 0) {
+            step.type = PHASE_STEP_END;
+            if (depth == 0) {
+                fprintf(stderr, "Error: %s: end without repeat\n", where);
+                goto error;
+            }
+            if (runs == runs_open[--depth]) {
+                fprintf(stderr, "Error: %s: the repeat block has no steps\n", where);
+                goto error;
+            }
+            step.count = open[depth];
+        }
+        else {
+            step.type = PHASE_STEP_RUN;
+            workload = parse_workload(word, *secondary);
+            if (workload < 0) {
+                fprintf(stderr, "Error: %s: unknown workload %s, use payload, secondary, idle, or a secondary workload\n", where, word);
+                goto error;
+            }
+            step.workload = (unsigned char) workload;
+            word = strtok_r(NULL, " \t\r\n", &save);
+            if ((word == NULL) || (parse_duration(&step, word) != EXIT_SUCCESS)) {
+                fprintf(stderr, "Error: %s: expected a duration (samples, a time in us, ms, or s, or *)\n", where);
+                goto error;
+            }
+            while ((word = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+                if (parse_option(&step, word, where) != EXIT_SUCCESS) goto error;
+            }
+            if ((workload == PHASE_IDLE) && (step.seconds == 0.0)) {
+                fprintf(stderr, "Error: %s: idle steps need a time as duration\n", where);
+                goto error;
+            }
+            if (buffered(workload)) {
+                if ((needs_buffer >= 0) && (needs_buffer != workload)) {
+                    fprintf(stderr, "Error: %s: only one of ptrchase and stream can be used, they need a buffer each\n", where);
+                    goto error;
+                }
+                needs_buffer = workload;
+            }
+            if ((workload == PHASE_IDLE) || step.seconds || step.cores) seq->uniform = 0;
+            if (step.pstate) seq->pstates = 1;
+            if (step.cap > 0.0) seq->caps = 1;
+            runs++;
+        }
+        if (seq->num_steps == max_steps) {
+            max_steps = max_steps ? 2 * max_steps : 64;
+            seq->steps = realloc(seq->steps, max_steps * sizeof(phase_step_t));
+            if (seq->steps == NULL) {
+                fprintf(stderr, "Error: cannot allocate the phase sequence\n");
+                goto error;
+            }
+        }
+        seq->steps[seq->num_steps++] = step;
+    }
+    fclose(stream);
+    if (depth) {
+        fprintf(stderr, "Error: %s: the repeat in line %u has no end\n", file, seq->steps[open[depth - 1]].line);
+        return EXIT_FAILURE;
+    }
+    if (runs == 0) {
+        fprintf(stderr, "Error: the phase sequence %s has no steps\n", file);
+        return EXIT_FAILURE;
+    }
+    if (needs_buffer >= 0) *secondary = needs_buffer;
+
+    return EXIT_SUCCESS;
+
+error:
+    fclose(stream);
+    free(seq->steps);
+    seq->steps = NULL;
+    seq->num_steps = 0;
+    return EXIT_FAILURE;
+}
+
+void phases_default(phase_seq_t *seq, phase_step_t *steps, const fsconfig_t *config, int secondary, unsigned int num_threads)
+{
+    /* with partition_time the partitions end at TSC deadlines, the threads take different numbers of samples */
+    unsigned long samples = (config->partition_time > 0.0) ? 0 : config->duty / config->partitions;
+    unsigned int n = 0;
+
+    memset(seq, 0, sizeof(phase_seq_t));
+    memset(steps, 0, PHASE_DEFAULT_STEPS * sizeof(phase_step_t));
+    seq->steps = steps;
+    seq->uniform = (samples != 0);
+
+    steps[n++].type = PHASE_STEP_REPEAT;
+    if (config->payload_partitions && config->secondary_partitions) {
+        steps[n].type = PHASE_STEP_REPEAT;
+        steps[n++].count = (unsigned int) config->payload_partitions;
+        steps[n].workload = 0;
+        steps[n++].samples = samples;
+        steps[n].type = PHASE_STEP_END;
+        steps[n++].count = 1;
+        steps[n].type = PHASE_STEP_REPEAT;
+        steps[n++].count = (unsigned int) config->secondary_partitions;
+        steps[n].workload = (unsigned char) secondary;
+        steps[n++].samples = samples;
+        steps[n].type = PHASE_STEP_END;
+        steps[n++].count = 4;
+    }
+    else {
+        /* without secondary partitions only the payload runs, without payload partitions only the secondary workload */
+        steps[n].workload = config->secondary_partitions ? (unsigned char) secondary : 0;
+        steps[n++].samples = samples;
+    }
+    steps[n].type = PHASE_STEP_END;
+    steps[n++].count = 0;
+    seq->num_steps = n;
+    for (n = 0; n < seq->num_steps; n++) {
+        if (steps[n].type != PHASE_STEP_RUN) continue;
+        steps[n].seconds = config->partition_time;
+        steps[n].num_active = num_threads;
+    }
+}
+
+/*
+ * moves from step i to the next PHASE_STEP_RUN step
+ */
+static unsigned int skip(const phase_seq_t *seq, unsigned int i, unsigned int *loops, unsigned int *depth)
+{
+    const phase_step_t *step;
+
+    while (i < seq->num_steps) {
+        step = &seq->steps[i];
+        if (step->type == PHASE_STEP_RUN) break;
+        if (step->type == PHASE_STEP_REPEAT) {
+            loops[(*depth)++] = step->count;
+            i++;
+        }
+        else if ((loops[*depth - 1] == 0) || (--loops[*depth - 1] > 0)) i = step->count + 1;
+        else {
+            (*depth)--;
+            i++;
+        }
+    }
+
+    return i;
+}
+
+void phases_first(const phase_seq_t *seq, unsigned int *pc, unsigned int *loops, unsigned int *depth)
+{
+    *depth = 0;
+    *pc = skip(seq, 0, loops, depth);
+}
+
+void phases_next(const phase_seq_t *seq, unsigned int *pc, unsigned int *loops, unsigned int *depth)
+{
+    *pc = skip(seq, *pc + 1, loops, depth);
+}
+
+const char *phases_workload(const phase_step_t *step)
+{
+    return (step->workload == PHASE_IDLE) ? "idle" : secondary_workloads[step->workload].name;
+}
+
+/*
+ * a / b, 0 if nothing was measured
+ */
+static double ratio(double a, double b)
+{
+    return (b > 0.0) ? a / b : 0.0;
+}
+
+void phases_report(FILE *stream, const phase_seq_t *seq, const phase_log_t *log, unsigned long num_log,
+                   unsigned long long clockrate, const char *file)
+{
+    FILE *trace = fopen(file, "w");
+    double seconds, joules, flops, bytes, *step_seconds, *step_joules, *step_flops, *step_bytes;
+    unsigned long long iterations, *step_iterations;
+    unsigned long *entries;
+    const phase_step_t *step;
+    unsigned long i;
+
+    if (trace == NULL) fprintf(stderr, "Warning: cannot write the phase trace %s\n", file);
+    else fprintf(trace, "# time [s]\tduration [s]\tstep\tline\tworkload\tactive\tpstate\tcap [W]\tsamples\titerations"
+                        "\tenergy [J]\tpower [W]\tGFLOPS\tGB/s\tGFLOPS/W\tbytes/J\tJ/iteration\n");
+    step_seconds = (double *) calloc(seq->num_steps, sizeof(double));
+    step_joules = (double *) calloc(seq->num_steps, sizeof(double));
+    step_flops = (double *) calloc(seq->num_steps, sizeof(double));
+    step_bytes = (double *) calloc(seq->num_steps, sizeof(double));
+    step_iterations = (unsigned long long *) calloc(seq->num_steps, sizeof(unsigned long long));
+    entries = (unsigned long *) calloc(seq->num_steps, sizeof(unsigned long));
+    for (i = 0; i + 1 < num_log; i++) {
+        if (log[i].step >= seq->num_steps) continue;
+        step = &seq->steps[log[i].step];
+        seconds = (double) (log[i + 1].tsc - log[i].tsc) / (double) clockrate;
+        joules = log[i + 1].joules - log[i].joules;
+        // loop iterations of all active threads, a timed step fits more of them at a higher frequency
+        iterations = log[i + 1].iterations - log[i].iterations;
+        flops = (double) (log[i + 1].flops - log[i].flops);
+        bytes = (double) (log[i + 1].bytes - log[i].bytes);
+        if (trace) {
+            fprintf(trace, "%.6f\t%.6f\t%u\t%u\t%s\t%u\t0x%lx\t%.1f\t%llu\t%llu\t%.3f\t%.2f\t%.3f\t%.3f\t%.4f\t%.4g\t%.4g\n",
+                (double) (log[i].tsc - log[0].tsc) / (double) clockrate, seconds, log[i].step, step->line,
+                phases_workload(step), step->num_active, step->pstate, step->cap, log[i + 1].samples - log[i].samples,
+                iterations, joules, ratio(joules, seconds), ratio(flops, seconds) * 0.000000001, ratio(bytes, seconds) * 0.000000001,
+                ratio(flops, joules) * 0.000000001, ratio(bytes, joules), ratio(joules, (double) iterations));
+        }
+        if (step_seconds && step_joules && step_flops && step_bytes && step_iterations && entries) {
+            step_seconds[log[i].step] += seconds;
+            step_joules[log[i].step] += joules;
+            step_flops[log[i].step] += flops;
+            step_bytes[log[i].step] += bytes;
+            step_iterations[log[i].step] += iterations;
+            entries[log[i].step]++;
+        }
+    }
+    if (trace) fclose(trace);
+
+    if (step_seconds && step_joules && step_flops && step_bytes && step_iterations && entries) {
+        fprintf(stream, "\nphases (all packages):\n");
+        for (i = 0; i < seq->num_steps; i++) {
+            if (entries[i] == 0) continue;
+            step = &seq->steps[i];
+            fprintf(stream, "  step %lu (line %u, %s): %lu times, %.3f s, %llu iterations, %.3f J, %.2f W\n", i, step->line,
+                phases_workload(step), entries[i], step_seconds[i], step_iterations[i], step_joules[i],
+                ratio(step_joules[i], step_seconds[i]));
+            if (step->workload == PHASE_IDLE) continue;
+            fprintf(stream, "    %.2f GFLOPS, %.2f GB/s, %.4f GFLOPS/W, %.4g bytes/J, %.4g J/iteration\n",
+                ratio(step_flops[i], step_seconds[i]) * 0.000000001, ratio(step_bytes[i], step_seconds[i]) * 0.000000001,
+                ratio(step_flops[i], step_joules[i]) * 0.000000001, ratio(step_bytes[i], step_joules[i]),
+                ratio(step_joules[i], (double) step_iterations[i]));
+        }
+    }
+    free(step_seconds);
+    free(step_joules);
+    free(step_flops);
+    free(step_bytes);
+    free(step_iterations);
+    free(entries);
+}
+
+void phases_efficiency(FILE *stream, const threaddata_t *threads, unsigned int num_threads, const threaddata_t *logger,
+                       unsigned int packages, unsigned long long clockrate, const char *file)
+{
+    static const char *phase_names[NUM_PHASES] = {"payload", "secondary"};
+    FILE *out = fopen(file, "w");
+    double seconds, joules, flops, bytes;
+    unsigned long long iterations;
+    unsigned int k, p, t;
+    char package[16];
+
+    if (out == NULL) fprintf(stderr, "Warning: cannot write the efficiency report %s\n", file);
+    else fprintf(out, "# package\tphase\ttime [s]\tenergy [J]\tpower [W]\titerations\tGFLOPS\tGB/s\tGFLOPS/W\tbytes/J\tJ/iteration\n");
+    fprintf(stream, "\nefficiency (per package and phase):\n");
+    for (k = 0; k < NUM_PHASES; k++) {
+        seconds = (double) logger->phase_wall[k] / (double) clockrate;
+        if (seconds == 0.0) continue;
+        // p == packages sums up all packages, only shown if there are several
+        for (p = 0; p <= packages; p++) {
+            if ((p == packages) && (packages == 1)) break;
+            joules = flops = bytes = 0.0;
+            iterations = 0;
+            for (t = 0; t < num_threads; t++) {
+                if ((p < packages) && (threads[t].package != p)) continue;
+                iterations += threads[t].efficiency_iterations[k];
+                flops += (double) threads[t].efficiency_flops[k];
+                bytes += (double) threads[t].efficiency_bytes[k];
+            }
+            for (t = 0; t < packages; t++) {
+                if ((p == packages) || (t == p)) joules += logger->phase_joules[t][k];
+            }
+            if (p < packages) snprintf(package, sizeof(package), "%u", p);
+            else snprintf(package, sizeof(package), "all");
+            fprintf(stream, "  package %s, %s: %.3f s, %llu iterations, %.3f J, %.2f W, %.2f GFLOPS, %.2f GB/s\n"
+                            "    %.4f GFLOPS/W, %.4g bytes/J, %.4g J/iteration\n",
+                package, phase_names[k], seconds, iterations, joules, ratio(joules, seconds),
+                ratio(flops, seconds) * 0.000000001, ratio(bytes, seconds) * 0.000000001,
+                ratio(flops, joules) * 0.000000001, ratio(bytes, joules), ratio(joules, (double) iterations));
+            if (out) {
+                fprintf(out, "%s\t%s\t%.6f\t%.3f\t%.2f\t%llu\t%.3f\t%.3f\t%.4f\t%.4g\t%.4g\n",
+                    package, phase_names[k], seconds, joules, ratio(joules, seconds), iterations,
+                    ratio(flops, seconds) * 0.000000001, ratio(bytes, seconds) * 0.000000001,
+                    ratio(flops, joules) * 0.000000001, ratio(bytes, joules), ratio(joules, (double) iterations));
+            }
+        }
+    }
+    if (out) fclose(out);
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+
+#ifndef __FIRESTARTER__PHASES_H
+#define __FIRESTARTER__PHASES_H
+
+#include <stdio.h>
+#include "firestarter_global.h"
+
+/*
+ * phase sequence of the experiment loop (--phases=FILE), one statement per line, # starts a comment:
+ *   WORKLOAD DURATION [pstate=VALUE] [cap=W] [cores=CPULIST]
+ *   repeat [N]                  (N times, forever without N)
+ *   end
+ * WORKLOAD is payload, secondary (the one of --secondary), a secondary workload name, or idle,
+ * DURATION is a number of samples, a time (us, ms, s), or * (until the end of the run),
+ * all threads change the step together, threads that are not in cores wait for the end of the step,
+ * timed steps end at absolute TSC deadlines that the threads check after each sample: consecutive timed
+ * steps are chained to the deadline of the previous one, so the transitions do not shift the schedule
+ */
+#define PHASE_STEP_RUN         0
+#define PHASE_STEP_REPEAT      1
+#define PHASE_STEP_END         2
+
+#define PHASE_IDLE             0xFF
+
+/*
+ * polling interval of the threads that wait for the end of a step in us
+ */
+#define PHASE_IDLE_US          50
+
+/*
+ * steps of the sequence built from the run configuration
+ */
+#define PHASE_DEFAULT_STEPS    8
+
+/*
+ * transitions with the energy of all packages and the samples, loop iterations, and operations of all threads
+ * in between, written to the output directory by the first thread
+ */
+#define PHASES_TRACE           "phases.trace"
+
+/*
+ * time, energy, and work of each package in the payload and secondary steps, written next to PHASES_TRACE
+ */
+#define PHASES_EFFICIENCY      "efficiency"
+
+/*
+ * reads the sequence in file, "secondary" refers to *secondary, which is set to the secondary workload that
+ * needs a buffer if a step uses one, returns EXIT_SUCCESS or EXIT_FAILURE after printing the reason
+ */
+extern int phases_read(phase_seq_t *seq, const char *file, int *secondary);
+
+/*
+ * builds the sequence of the run configuration in steps (PHASE_DEFAULT_STEPS): payload_partitions partitions
+ * of duty / partitions samples (or partition_time) run the payload, then secondary_partitions the secondary
+ * workload, repeated
+ */
+extern void phases_default(phase_seq_t *seq, phase_step_t *steps, const fsconfig_t *config, int secondary, unsigned int num_threads);
+
+/*
+ * moves pc, loops, and depth to the first PHASE_STEP_RUN step of the sequence,
+ * or from the current one to the next, pc is num_steps at the end
+ */
+extern void phases_first(const phase_seq_t *seq, unsigned int *pc, unsigned int *loops, unsigned int *depth);
+extern void phases_next(const phase_seq_t *seq, unsigned int *pc, unsigned int *loops, unsigned int *depth);
+
+/*
+ * name of the workload of a step
+ */
+extern const char *phases_workload(const phase_step_t *step);
+
+/*
+ * writes the transitions in log to file and prints time, iterations, energy, power, and efficiency of each step to stream
+ */
+extern void phases_report(FILE *stream, const phase_seq_t *seq, const phase_log_t *log, unsigned long num_log,
+                          unsigned long long clockrate, const char *file);
+
+/*
+ * prints GFLOPS/W, bytes/J, and J/iteration of the payload and secondary steps per package (the energy of the package
+ * and the work of the threads on it) to stream and writes them to file, logger is the thread that logged the transitions
+ */
+extern void phases_efficiency(FILE *stream, const threaddata_t *threads, unsigned int num_threads, const threaddata_t *logger,
+                              unsigned int packages, unsigned long long clockrate, const char *file);
+
+#endif
+
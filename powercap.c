@@ -0,0 +1,328 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <math.h>
+#include "powercap.h"
+#include "msrio.h"
+
+#define ENERGY_UNIT 0x606
+#define POWER_LIMIT 0x610
+#define ENERGY_STATUS 0x611
+
+/* the power is steady once all following samples of the step are within this fraction of its mean */
+#define SETTLE_TOLERANCE 0.05
+
+int powercap_read(powercap_t *schedule, const char *file)
+{
+    FILE *stream = fopen(file, "r");
+    char line[256], *comment;
+    unsigned int lineno = 0, max_steps = 0;
+    powercap_step_t step;
+    int n;
+
+    memset(schedule, 0, sizeof(powercap_t));
+    if (stream == NULL) {
+        fprintf(stderr, "Error: cannot open the RAPL schedule %s\n", file);
+        return EXIT_FAILURE;
+    }
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        lineno++;
+        comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        memset(&step, 0, sizeof(step));
+        n = sscanf(line, "%lf %lf %lf %lf %lf", &step.offset, &step.pl1_power, &step.pl1_window, &step.pl2_power, &step.pl2_window);
+        if (n <= 0) continue;
+        if (n != 5) {
+            fprintf(stderr, "Error: %s:%u: expected TIME PL1_POWER PL1_WINDOW PL2_POWER PL2_WINDOW\n", file, lineno);
+            goto error;
+        }
+        if ((step.offset < 0.0) || (schedule->num_steps && (step.offset < schedule->steps[schedule->num_steps - 1].offset))) {
+            fprintf(stderr, "Error: %s:%u: the times have to be ascending and not negative\n", file, lineno);
+            goto error;
+        }
+        if ((step.pl1_power < 0.0) || (step.pl1_power > 4095.0) || (step.pl2_power < 0.0) || (step.pl2_power > 4095.0)) {
+            fprintf(stderr, "Error: %s:%u: the power limits have to be in [0, 4095] W\n", file, lineno);
+            goto error;
+        }
+        if ((step.pl1_window < 0.001) || (step.pl1_window > 40.0) || (step.pl2_window < 0.001) || (step.pl2_window > 40.0)) {
+            fprintf(stderr, "Error: %s:%u: the time windows have to be in [0.001, 40] s\n", file, lineno);
+            goto error;
+        }
+        if (schedule->num_steps == max_steps) {
+            max_steps = max_steps ? 2 * max_steps : 64;
+            schedule->steps = realloc(schedule->steps, max_steps * sizeof(powercap_step_t));
+            if (schedule->steps == NULL) {
+                fprintf(stderr, "Error: cannot allocate the RAPL schedule\n");
+                goto error;
+            }
+        }
+        schedule->steps[schedule->num_steps++] = step;
+    }
+    fclose(stream);
+    if (schedule->num_steps == 0) {
+        fprintf(stderr, "Error: the RAPL schedule %s has no steps\n", file);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+
+error:
+    fclose(stream);
+    free(schedule->steps);
+    schedule->steps = NULL;
+    schedule->num_steps = 0;
+    return EXIT_FAILURE;
+}
+
+uint64_t powercap_encode(double watts, double window, double power_unit, double time_unit)
+{
+    uint64_t power = (uint64_t) (watts / power_unit + 0.5);
+    uint64_t y, z, best_y = 0, best_z = 0;
+    double error, best_error = -1.0;
+
+    if (watts == 0.0) return 0;
+    if (power > 0x7FFF) power = 0x7FFF;
+    for (y = 0; y < 32; y++) {
+        for (z = 0; z < 4; z++) {
+            error = fabs(ldexp(1.0 + z / 4.0, (int) y) * time_unit - window);
+            if ((best_error < 0.0) || (error < best_error)) {
+                best_error = error;
+                best_y = y;
+                best_z = z;
+            }
+        }
+    }
+
+    return power | (1UL << 15) | (1UL << 16) | (best_y << 17) | (best_z << 22);
+}
+
+void powercap_energy(unsigned int packages, uint64_t *energy)
+{
+    unsigned int p;
+
+    for (p = 0; p < packages; p++) {
+        energy[p] = 0;
+        msrio_read_package(p, ENERGY_STATUS, &energy[p]);
+    }
+}
+
+/*
+ * takes a power sample since the previous one, event marks the sample that is taken right after a step
+ * was applied (it still belongs to the previous step), returns the energy counter
+ */
+static uint64_t sample_power(powercap_t *schedule, uint64_t last_energy, unsigned long long *last_tsc, unsigned int event)
+{
+    powercap_sample_t *sample;
+    unsigned long long tsc;
+    uint64_t energy = 0;
+
+    msrio_read_package(schedule->package, ENERGY_STATUS, &energy);
+    tsc = timestamp();
+    if (schedule->num_samples == schedule->max_samples) {
+        powercap_sample_t *samples = realloc(schedule->samples, 2 * schedule->max_samples * sizeof(powercap_sample_t));
+        if (samples == NULL) return energy;
+        schedule->samples = samples;
+        schedule->max_samples *= 2;
+    }
+    sample = &schedule->samples[schedule->num_samples++];
+    sample->tsc = tsc;
+    // ENERGY_STATUS is a 32 bit counter
+    sample->watts = (tsc > *last_tsc) ? (double) ((energy - last_energy) & 0xFFFFFFFFUL) * schedule->energy_unit
+                                        * (double) schedule->clockrate / (double) (tsc - *last_tsc) : 0.0;
+    sample->step = schedule->current;
+    sample->event = event;
+    *last_tsc = tsc;
+
+    return energy;
+}
+
+/*
+ * applies the steps at their deadlines and samples the package power in between
+ */
+static void *powercap_thread(void *arg)
+{
+    powercap_t *schedule = (powercap_t *)arg;
+    unsigned long long sample_tsc = schedule->clockrate / 1000000 * POWERCAP_SAMPLE_US;
+    unsigned long long spin_tsc = schedule->clockrate / 1000000 * POWERCAP_SPIN_US;
+    unsigned long long now, next_sample, next, last_tsc = schedule->start_tsc;
+    powercap_step_t *step;
+    uint64_t energy = 0;
+
+    msrio_read_package(schedule->package, ENERGY_STATUS, &energy);
+    next_sample = schedule->start_tsc + sample_tsc;
+    while (!schedule->stop) {
+        now = timestamp();
+        if ((schedule->current < schedule->num_steps) && (now >= schedule->steps[schedule->current].deadline)) {
+            step = &schedule->steps[schedule->current];
+            msrio_write_package(schedule->package, POWER_LIMIT, step->limit);
+            step->applied = timestamp();
+            // the sample closes the interval under the previous limit
+            energy = sample_power(schedule, energy, &last_tsc, 1);
+            schedule->current++;
+            next_sample = last_tsc + sample_tsc;
+            continue;
+        }
+        if (now >= next_sample) {
+            energy = sample_power(schedule, energy, &last_tsc, 0);
+            next_sample += sample_tsc;
+            if (next_sample < last_tsc) next_sample = last_tsc + sample_tsc;
+            continue;
+        }
+        next = next_sample;
+        if ((schedule->current < schedule->num_steps) && (schedule->steps[schedule->current].deadline < next)) {
+            next = schedule->steps[schedule->current].deadline;
+        }
+        if (next - now > spin_tsc) usleep((useconds_t) ((next - now - spin_tsc) / (schedule->clockrate / 1000000)));
+    }
+    sample_power(schedule, energy, &last_tsc, 0);
+
+    return NULL;
+}
+
+int powercap_start(powercap_t *schedule, volatile mydata_t *data, unsigned int package, unsigned long long start_tsc)
+{
+    uint64_t unit = 0;
+    unsigned int i;
+    pthread_attr_t attr;
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+    cpu_set_t mask;
+    long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    int c;
+#endif
+
+    schedule->package = package;
+    schedule->start_tsc = start_tsc;
+    schedule->clockrate = data->cpuinfo->clockrate;
+    msrio_read_package(package, ENERGY_UNIT, &unit);
+    schedule->power_unit = 1.0 / (double) (1UL << (unit & 0xF));
+    schedule->energy_unit = 1.0 / (double) (1UL << ((unit >> 8) & 0x1F));
+    schedule->time_unit = 1.0 / (double) (1UL << ((unit >> 16) & 0xF));
+    msrio_read_package(package, POWER_LIMIT, &schedule->saved_limit);
+    for (i = 0; i < schedule->num_steps; i++) {
+        powercap_step_t *step = &schedule->steps[i];
+        step->deadline = start_tsc + (unsigned long long) (step->offset * (double) schedule->clockrate);
+        step->limit = powercap_encode(step->pl1_power, step->pl1_window, schedule->power_unit, schedule->time_unit)
+                    | (powercap_encode(step->pl2_power, step->pl2_window, schedule->power_unit, schedule->time_unit) << 32);
+        step->applied = 0;
+    }
+    schedule->max_samples = 4096;
+    schedule->num_samples = 0;
+    schedule->samples = malloc(schedule->max_samples * sizeof(powercap_sample_t));
+    if (schedule->samples == NULL) {
+        fprintf(stderr, "Error: cannot allocate the samples of the RAPL schedule\n");
+        return EXIT_FAILURE;
+    }
+    schedule->current = 0;
+    schedule->stop = 0;
+    pthread_attr_init(&attr);
+#if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
+    /* the payload never yields: the control thread runs on the CPUs without a worker thread, on any CPU if all are used */
+    CPU_ZERO(&mask);
+    for (c = 0; (c < cpus) && (c < CPU_SETSIZE); c++) CPU_SET(c, &mask);
+    for (i = 0; i < data->num_threads; i++) CPU_CLR(data->threaddata[i].cpu_id, &mask);
+    if (CPU_COUNT(&mask) == 0) for (c = 0; (c < cpus) && (c < CPU_SETSIZE); c++) CPU_SET(c, &mask);
+    pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &mask);
+#endif
+    i = pthread_create(&schedule->thread, &attr, powercap_thread, schedule);
+    pthread_attr_destroy(&attr);
+    if (i != 0) {
+        fprintf(stderr, "Error: cannot start the control thread of the RAPL schedule\n");
+        return EXIT_FAILURE;
+    }
+    schedule->started = 1;
+
+    return EXIT_SUCCESS;
+}
+
+void powercap_stop(powercap_t *schedule)
+{
+    if (!schedule->started) return;
+    schedule->stop = 1;
+    pthread_join(schedule->thread, NULL);
+    msrio_write_package(schedule->package, POWER_LIMIT, schedule->saved_limit);
+    schedule->started = 0;
+}
+
+void powercap_report(FILE *stream, const powercap_t *schedule, const char *file)
+{
+    FILE *out;
+    const powercap_step_t *step;
+    const powercap_sample_t *sample;
+    unsigned long i, first, last, settled;
+    unsigned int s;
+    double mean, time;
+
+    if (schedule->samples == NULL) return;
+    out = fopen(file, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Error: cannot write %s\n", file);
+    }
+    else {
+        fprintf(out, "time\tpower\tstep\tpl1\tpl2\tevent\n");
+        for (i = 0; i < schedule->num_samples; i++) {
+            sample = &schedule->samples[i];
+            step = sample->step ? &schedule->steps[sample->step - 1] : NULL;
+            fprintf(out, "%.6f\t%.3f\t%u\t%.3f\t%.3f\t%s\n",
+                    (double) (sample->tsc - schedule->start_tsc) / (double) schedule->clockrate, sample->watts, sample->step,
+                    step ? step->pl1_power : 0.0, step ? step->pl2_power : 0.0, sample->event ? "apply" : "-");
+        }
+        fclose(out);
+    }
+
+    fprintf(stream, "\nRAPL schedule (trace in %s):\n", file);
+    fprintf(stream, "  step  time [s]  PL1 [W]  PL2 [W]  late [us]  mean [W]  steady [W]  settled after [ms]\n");
+    for (s = 0; s < schedule->num_steps; s++) {
+        step = &schedule->steps[s];
+        if (!step->applied) {
+            fprintf(stream, "  %4u  %8.3f  %7.1f  %7.1f  not applied\n", s + 1, step->offset, step->pl1_power, step->pl2_power);
+            continue;
+        }
+        // samples under this step, up to the one that is taken when the next step is applied
+        for (first = 0; (first < schedule->num_samples) && (schedule->samples[first].step <= s); first++);
+        for (last = first; (last < schedule->num_samples) && (schedule->samples[last].step == s + 1); last++);
+        if (first == last) {
+            fprintf(stream, "  %4u  %8.3f  %7.1f  %7.1f  %9.1f  no samples\n", s + 1, step->offset, step->pl1_power, step->pl2_power,
+                    (double) (step->applied - step->deadline) * 1000000.0 / (double) schedule->clockrate);
+            continue;
+        }
+        for (mean = 0.0, i = first; i < last; i++) mean += schedule->samples[i].watts;
+        mean /= (double) (last - first);
+        // steady state: the second half of the step
+        double steady = 0.0;
+        for (i = first + (last - first) / 2; i < last; i++) steady += schedule->samples[i].watts;
+        steady /= (double) (last - first - (last - first) / 2);
+        for (settled = last; settled > first; settled--) {
+            if (fabs(schedule->samples[settled - 1].watts - steady) > SETTLE_TOLERANCE * steady) break;
+        }
+        time = (settled < last) ? (double) (schedule->samples[settled].tsc - step->applied) * 1000.0 / (double) schedule->clockrate : -1.0;
+        fprintf(stream, "  %4u  %8.3f  %7.1f  %7.1f  %9.1f  %8.2f  %10.2f  ", s + 1, step->offset, step->pl1_power, step->pl2_power,
+                (double) (step->applied - step->deadline) * 1000000.0 / (double) schedule->clockrate, mean, steady);
+        if (time < 0.0) fprintf(stream, "not settled\n");
+        else fprintf(stream, "%.1f\n", (time > 0.0) ? time : 0.0);
+    }
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__POWERCAP_H
+#define __FIRESTARTER__POWERCAP_H
+
+#include <stdio.h>
+#include "firestarter_global.h"
+
+/*
+ * RAPL limit schedule (--rapl-schedule=FILE): one step per line,
+ *   TIME PL1_POWER PL1_WINDOW PL2_POWER PL2_WINDOW
+ * TIME is the offset from the start of the experiment loop in s (ascending), powers are in W (0 disables
+ * the limit), windows are in s, # starts a comment
+ */
+
+/*
+ * interval of the power samples of the control thread in us, the control thread sleeps until
+ * POWERCAP_SPIN_US before the next deadline and spins on the TSC for the rest
+ */
+#define POWERCAP_SAMPLE_US     10000
+#define POWERCAP_SPIN_US       200
+
+/*
+ * trace of the control thread: power samples next to the applied limits, written to the working directory
+ */
+#define POWERCAP_TRACE         "powercap.trace"
+
+/*
+ * one half of POWER_LIMIT: power (bits 14:0), enable and clamp (bits 15 and 16),
+ * time window 2^Y * (1 + Z/4) time units (Y: bits 21:17, Z: bits 23:22), the closest window is used,
+ * 0 W disables the limit
+ */
+extern uint64_t powercap_encode(double watts, double window, double power_unit, double time_unit);
+
+/*
+ * reads ENERGY_STATUS of the first packages (up to MAX_PACKAGES), McKernel only reads the package of the calling CPU
+ */
+extern void powercap_energy(unsigned int packages, uint64_t *energy);
+
+/*
+ * reads the schedule in file, returns EXIT_SUCCESS or EXIT_FAILURE after printing the reason
+ */
+extern int powercap_read(powercap_t *schedule, const char *file);
+
+/*
+ * starts the control thread for the given package on the CPUs that do not run a worker thread of data (on any CPU
+ * if all of them do), the offsets of the steps are relative to start_tsc
+ */
+extern int powercap_start(powercap_t *schedule, volatile mydata_t *data, unsigned int package, unsigned long long start_tsc);
+
+/*
+ * stops the control thread and restores POWER_LIMIT, does nothing if it is not running
+ */
+extern void powercap_stop(powercap_t *schedule);
+
+/*
+ * writes the trace to file and prints the response of the power to each step to stream
+ */
+extern void powercap_report(FILE *stream, const powercap_t *schedule, const char *file);
+
+#endif
+
@@ -0,0 +1,201 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <emmintrin.h>
+#include <mm_malloc.h>
+#include "secondary.h"
+#include "work.h"
+
+/* the counters in threaddata_t have an entry for each secondary workload */
+typedef char check_max_secondary[(NUM_SECONDARY <= MAX_SECONDARY) ? 1 : -1];
+
+const secondary_workload_t secondary_workloads[NUM_SECONDARY] = {
+    /* name       iterations  flops  bytes */
+    { "payload",  0,          0,     0  },  /* ID 0 is the FIRESTARTER payload */
+    { "int",      550000,     0,     0  },  /* chain of 3 dependent scalar adds */
+    { "ptrchase", 4096,       0,     64 },  /* one dependent load from a random cache line */
+    { "stream",   131072,     0,     64 },  /* one cache line read in sequential order */
+    { "sse",      250000,     16,    0  },  /* 4 addpd and 4 mulpd on 128 bit registers */
+    { "pause",    10000,      0,     0  },  /* one pause instruction */
+    { "sleep",    1,          0,     0  },  /* usleep(SECONDARY_SLEEP_USEC) */
+};
+
+int get_secondary(const char *name)
+{
+    int i;
+
+    for (i = 1; i < NUM_SECONDARY; i++) {
+        if (strcmp(name, secondary_workloads[i].name) == 0) return i;
+    }
+    fprintf(stderr, "\nError: unknown secondary workload: %s, valid values:", name);
+    for (i = 1; i < NUM_SECONDARY; i++) fprintf(stderr, " %s", secondary_workloads[i].name);
+    fprintf(stderr, "\n\n");
+
+    return FUNC_UNKNOWN;
+}
+
+/*
+ * link all cache lines of the buffer to a single cycle in random order, returns EXIT_FAILURE if the
+ * permutation cannot be allocated
+ */
+static int init_ptrchase(threaddata_t *threaddata)
+{
+    unsigned long long lines = SECONDARY_BUFFERSIZE / 64;
+    unsigned long long *perm = malloc(lines * sizeof(unsigned long long));
+    unsigned int seed = threaddata->thread_id + 1;
+    unsigned long long i, j, tmp;
+
+    if (perm == NULL) return EXIT_FAILURE;
+    for (i = 0; i < lines; i++) perm[i] = i;
+    for (i = lines - 1; i > 0; i--) {
+        j = ((unsigned long long)rand_r(&seed) * RAND_MAX + rand_r(&seed)) % i;
+        tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+    for (i = 0; i < lines; i++) {
+        *((char **)(threaddata->secondaryMem + perm[i] * 64)) = threaddata->secondaryMem + perm[(i + 1) % lines] * 64;
+    }
+    free(perm);
+
+    return EXIT_SUCCESS;
+}
+
+int init_secondary(threaddata_t *threaddata)
+{
+    threaddata->secondaryMem = NULL;
+    threaddata->secondaryPos = 0;
+
+    if ((threaddata->secondary != SEC_PTRCHASE) && (threaddata->secondary != SEC_STREAM)) return EXIT_SUCCESS;
+
+    threaddata->secondaryMem = _mm_malloc(SECONDARY_BUFFERSIZE, threaddata->alignment);
+    if (threaddata->secondaryMem == NULL) return EXIT_FAILURE;
+
+    if (threaddata->secondary == SEC_PTRCHASE) {
+        if (init_ptrchase(threaddata) != EXIT_SUCCESS) {
+            _mm_free(threaddata->secondaryMem);
+            threaddata->secondaryMem = NULL;
+            return EXIT_FAILURE;
+        }
+    }
+    else memset(threaddata->secondaryMem, 1, SECONDARY_BUFFERSIZE);
+
+    return EXIT_SUCCESS;
+}
+
+static unsigned long long int_work(unsigned long long iterations)
+{
+    unsigned long long a = 0, b = 0, c = 0, i;
+
+    for (i = 0; i < iterations; i++) {
+        __asm__ __volatile__(
+            "addq %%rdx, %%rax\n\t"
+            "addq %%rax, %%rbx\n\t"
+            "addq %%rbx, %%rcx\n\t"
+            : "+a" (a), "+b" (b), "+c" (c)
+            : "d" (i)
+        );
+    }
+    return a | b | c;
+}
+
+static unsigned long long ptrchase_work(threaddata_t *threaddata, unsigned long long iterations)
+{
+    char **p = (char **)(threaddata->secondaryMem + threaddata->secondaryPos);
+    unsigned long long i;
+
+    for (i = 0; i < iterations; i++) p = (char **)*p;
+    threaddata->secondaryPos = (char *)p - threaddata->secondaryMem;
+
+    return (unsigned long long)p;
+}
+
+static unsigned long long stream_work(threaddata_t *threaddata, unsigned long long iterations)
+{
+    volatile unsigned long long *p;
+    unsigned long long sum = 0, i;
+
+    for (i = 0; i < iterations; i++) {
+        p = (volatile unsigned long long *)(threaddata->secondaryMem + threaddata->secondaryPos);
+        sum += p[0] + p[1] + p[2] + p[3] + p[4] + p[5] + p[6] + p[7];
+        threaddata->secondaryPos += 64;
+        if (threaddata->secondaryPos >= SECONDARY_BUFFERSIZE) threaddata->secondaryPos = 0;
+    }
+    return sum;
+}
+
+static unsigned long long sse_work(unsigned long long iterations)
+{
+    __m128d a0 = _mm_set1_pd(1.0), a1 = _mm_set1_pd(1.1), a2 = _mm_set1_pd(1.2), a3 = _mm_set1_pd(1.3);
+    __m128d m0 = _mm_set1_pd(0.999999), m1 = _mm_set1_pd(1.000001);
+    __m128d inc = _mm_set1_pd(0.000001);
+    unsigned long long i;
+    double res[2];
+
+    for (i = 0; i < iterations; i++) {
+        a0 = _mm_mul_pd(_mm_add_pd(a0, inc), m0);
+        a1 = _mm_mul_pd(_mm_add_pd(a1, inc), m1);
+        a2 = _mm_mul_pd(_mm_add_pd(a2, inc), m0);
+        a3 = _mm_mul_pd(_mm_add_pd(a3, inc), m1);
+    }
+    _mm_storeu_pd(res, _mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3)));
+
+    return (unsigned long long)(res[0] + res[1]);
+}
+
+static unsigned long long pause_work(unsigned long long iterations)
+{
+    unsigned long long i;
+
+    for (i = 0; i < iterations; i++) __asm__ __volatile__("pause;");
+    return iterations;
+}
+
+unsigned long long secondary_work(threaddata_t *threaddata)
+{
+    unsigned long long iterations = secondary_workloads[threaddata->secondary].iterations;
+
+    switch (threaddata->secondary)
+    {
+        case SEC_INT:
+            return int_work(iterations);
+        case SEC_PTRCHASE:
+            return ptrchase_work(threaddata, iterations);
+        case SEC_STREAM:
+            return stream_work(threaddata, iterations);
+        case SEC_SSE:
+            return sse_work(iterations);
+        case SEC_PAUSE:
+            return pause_work(iterations);
+        case SEC_SLEEP:
+            usleep(SECONDARY_SLEEP_USEC);
+            return iterations;
+        default:
+            fprintf(stderr, "Error: unknown secondary workload %i\n", threaddata->secondary);
+            pthread_exit(NULL);
+    }
+}
+
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__SECONDARY_H
+#define __FIRESTARTER__SECONDARY_H
+
+#include "firestarter_global.h"
+
+/*
+ * secondary workloads for the alternating phases of the experiment loop,
+ * the IDs are written to the workload column of the trace (0 is the FIRESTARTER payload)
+ */
+#define SEC_INT                1
+#define SEC_PTRCHASE           2
+#define SEC_STREAM             3
+#define SEC_SSE                4
+#define SEC_PAUSE              5
+#define SEC_SLEEP              6
+#define NUM_SECONDARY          7 /* highest ID + 1 */
+
+#define SECONDARY_BUFFERSIZE   (64UL * 1024UL * 1024UL) /* per thread, pointer-chase and stream buffer */
+#define SECONDARY_SLEEP_USEC   500
+
+/*
+ * description of a secondary workload, work is given per call of secondary_work()
+ */
+typedef struct secondary_workload {
+    const char *name;
+    unsigned long long iterations;  /* loop iterations per call */
+    unsigned long long flops;       /* floating point operations per iteration */
+    unsigned long long bytes;       /* bytes read or written per iteration */
+} secondary_workload_t;
+
+extern const secondary_workload_t secondary_workloads[NUM_SECONDARY];
+
+/*
+ * returns the ID of the secondary workload with the given name, FUNC_UNKNOWN if there is none
+ */
+extern int get_secondary(const char *name);
+
+/*
+ * allocates and initializes the buffer of the secondary workload selected in threaddata->secondary
+ */
+extern int init_secondary(threaddata_t *threaddata);
+
+/*
+ * executes one call of the selected secondary workload, the result only prevents optimization
+ */
+extern unsigned long long secondary_work(threaddata_t *threaddata);
+
+#endif
+
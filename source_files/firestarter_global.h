@@ -68,6 +68,9 @@ $MAC
 
 #define INIT_BLOCKSIZE  8192
 
+/* initial value of the registers of the integer shift operations in the payload */
+#define DEFAULT_SHIFT_SEED 0xAAAAAAAA
+
 /*
  * watchdog timer
  */
@@ -100,6 +103,11 @@ typedef struct threaddata
    unsigned long long addrHigh;             
    unsigned long long buffersizeMem;
    unsigned long long iterations;
+   unsigned long long chunk;        /* loop iterations per asm_work call, 0 = until load level changes */
+   unsigned int shift_seed;         /* initial value of the shift registers of the payload */
+   unsigned long long buffersize[MAX_CACHELEVELS + 1]; /* L1, L2, L3, and RAM part of the buffer in bytes */
+   unsigned long long reset_count[MAX_CACHELEVELS];    /* loop iterations until the L2, L3, and RAM pointers are reset */
+   unsigned long long results[256]; /* vector registers at the end of the last payload call (*_functions.S), up to 32 zmm */
    unsigned long long flops;
 $$ TODO   unsigned long long bytes[5];      // total, L1*, L2*, L3*, RAM*  *:estimates
    unsigned long long bytes;
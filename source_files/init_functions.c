@@ -21,6 +21,19 @@
 
 #include "work.h"
 
+/*
+ * loop iterations until the pointer of a buffer level is reset: the covered part of the level divided by
+ * the cache lines that one loop iteration accesses in it, at least 1, 0 if the level is not accessed
+ */
+unsigned long long buffer_reset_count(unsigned long long size, double cover, unsigned int lines)
+{
+    unsigned long long count;
+
+    if (lines == 0) return 0;
+    count = (unsigned long long)(cover * size) / 64 / lines;
+    return count ? count : 1;
+}
+
 $TEMPLATE sse2_functions_c.init_functions(dest,architectures)
 
 $TEMPLATE avx_functions_c.init_functions(dest,architectures)
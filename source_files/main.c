@@ -205,7 +205,11 @@ $$        }
         mdp->threaddata[t].cpu_id = cpu_bind[t];
         mdp->threaddata[t].data = mdp;
         mdp->threaddata[t].buffersizeMem = BUFFERSIZEMEM;
+        for (i = 0; i < MAX_CACHELEVELS; i++) mdp->threaddata[t].buffersize[i] = BUFFERSIZE[i];
+        mdp->threaddata[t].buffersize[MAX_CACHELEVELS] = RAMBUFFERSIZE;
         mdp->threaddata[t].iterations = 0;
+        mdp->threaddata[t].chunk = 0;
+        mdp->threaddata[t].shift_seed = DEFAULT_SHIFT_SEED;
         mdp->threaddata[t].flops = 0;
 $$        for (i=0;i<5;i++) mdp->threaddata[t].bytes[i] = 0;
         mdp->threaddata[t].bytes = 0;
@@ -269,7 +273,7 @@ $TEMPLATE main_c.get_function_cases(dest,architectures)
  */
 static void evaluate_environment()
 {
-    unsigned int i;
+    unsigned int i, threads = 1;
 #if (defined(linux) || defined(__linux__)) && defined (AFFINITY)
     unsigned int j = 0;
 #endif
@@ -455,6 +459,16 @@ $TEMPLATE main_c.evaluate_environment_set_buffersize(dest,architectures)
         exit(1);
     }
 
+    /* L1, L2, and L3 part of the buffer: share of each thread in the detected caches, the sizes above are used for caches that are not detected */
+    if (BUFFERSIZE[0] > 0) {
+        cache_buffersizes(cpuinfo, threads, BUFFERSIZE);
+        if (verbose) {
+            printf("\n  Used buffersizes per thread:\n");
+            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf("    - L%d-Cache: %d Bytes\n", i + 1, BUFFERSIZE[i]);
+            printf("    - Memory: %llu Bytes\n\n", RAMBUFFERSIZE);
+        }
+    }
+
 }
 
 int main(int argc, char *argv[])
@@ -109,6 +109,8 @@ static DWORD WINAPI WorkerThread(void* threadParams)
   void * p;
 
   data->iterations=0;
+  data->chunk=0;
+  data->shift_seed=DEFAULT_SHIFT_SEED;
   data->start_tsc=timestamp();
 
   switch (data->FUNCTION) {
@@ -28,6 +28,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <stddef.h>
 
 #ifdef ENABLE_VTRACING
 #include <vt_user.h>
@@ -41,6 +42,20 @@
  */
 #include "work.h"
 #include "cpu.h"
+#include "asm_offsets.h"
+
+/*
+ * the assembler implementations in *_functions.S access threaddata_t through the offsets in asm_offsets.h
+ */
+typedef char check_td_addrMem[(offsetof(threaddata_t, addrMem) == TD_ADDRMEM) ? 1 : -1];
+typedef char check_td_addrHigh[(offsetof(threaddata_t, addrHigh) == TD_ADDRHIGH) ? 1 : -1];
+typedef char check_td_iterations[(offsetof(threaddata_t, iterations) == TD_ITERATIONS) ? 1 : -1];
+typedef char check_td_chunk[(offsetof(threaddata_t, chunk) == TD_CHUNK) ? 1 : -1];
+typedef char check_td_shift_seed[(offsetof(threaddata_t, shift_seed) == TD_SHIFT_SEED) ? 1 : -1];
+typedef char check_td_buffersize[(offsetof(threaddata_t, buffersize) == TD_BUFFERSIZE) ? 1 : -1];
+typedef char check_td_reset_count[(offsetof(threaddata_t, reset_count) == TD_RESET_COUNT) ? 1 : -1];
+typedef char check_td_results[(offsetof(threaddata_t, results) == TD_RESULTS) ? 1 : -1];
+typedef char check_td_results_size[(sizeof(((threaddata_t *) 0)->results) == TD_RESULTS_SIZE) ? 1 : -1];
 
 /*
  * low load function
@@ -64,6 +79,32 @@ int low_load_function(volatile unsigned long long addrHigh, unsigned int period)
     return 0;
 }
 
+/*
+ * per thread share of the L1, L2, and L3 cache in bytes, derived from the detected cache sizes, the number of cores
+ * that share each cache, and the threads per core of the selected function (1T, 2T, 4T), levels that are not detected
+ * keep the given size
+ */
+void cache_buffersizes(cpu_info_t *cpuinfo, unsigned int threads, unsigned int *buffersize)
+{
+    unsigned long long size;
+    unsigned int i, shared, smt;
+
+    smt = cpuinfo->num_threads_per_core ? cpuinfo->num_threads_per_core : 1;
+    for (i = 0; i < MAX_CACHELEVELS; i++){
+        size = cpuinfo->Cache_unified[i] ? cpuinfo->U_Cache_Size[i] : cpuinfo->D_Cache_Size[i];
+        shared = cpuinfo->Cache_shared[i];
+        if ((shared == 0) || (shared > cpuinfo->num_cpus)){
+            /* sharing not reported: L1 and L2 belong to a core, L3 to a package */
+            if (i < 2) shared = smt;
+            else if (cpuinfo->num_packages) shared = cpuinfo->num_cpus / cpuinfo->num_packages;
+        }
+        if ((size == 0) || (shared == 0) || (shared > cpuinfo->num_cpus) || (threads == 0)) continue;
+        /* Cache_shared counts hardware threads, the function runs threads on each of the cores that share the cache */
+        shared = (shared + smt - 1) / smt * threads;
+        buffersize[i] = size / shared / 64 * 64;
+    }
+}
+
 /*
  * function that performs the stress test
  */
@@ -40,6 +40,12 @@ extern void _work(volatile mydata_t* data, unsigned long long *high);
  */
 extern void *thread(void *threaddata);
 
+/*
+ * buffer sizes derived from the detected caches (work.c) and reset counters of the buffer pointers (init_functions.c)
+ */
+extern void cache_buffersizes(cpu_info_t *cpuinfo, unsigned int threads, unsigned int *buffersize);
+extern unsigned long long buffer_reset_count(unsigned long long size, double cover, unsigned int lines);
+
 /*
  * init functions
  */
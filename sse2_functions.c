@@ -30,10 +30,16 @@ int asm_work_nhm_corei_sse2_1t(threaddata_t* threaddata) __attribute__((noinline
 int asm_work_nhm_corei_sse2_1t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -49,12 +55,14 @@ int asm_work_nhm_corei_sse2_1t(threaddata_t* threaddata)
          *   - r12:      stores cacheline width as increment for buffer addresses
          *   - r13:      stores address of shared variable that controls load level
          *   - r14:      stores iteration counter
+         *   - r15:      stores number of iterations left in this call
          *   - mm*,xmm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize SSE-Registers for Addition
         "movapd 0(%%rax), %%xmm0;"
@@ -80,14 +88,14 @@ int asm_work_nhm_corei_sse2_1t(threaddata_t* threaddata)
         "pinsrq $1, %%r11, %%xmm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $32768, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $262144, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $1572864, %%rdi;" // address for RAM-buffer
-        "movabs $0, %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $0, %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $78019, %%r10;" // reset-counter for RAM-buffer with 21 cache lines accessed per loop (102399.94 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 21 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_nhm_corei_sse2_1t:"
@@ -1629,18 +1637,22 @@ int asm_work_nhm_corei_sse2_1t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_nhm_corei_sse2_1t;"
-        "movabs $78019, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $1572864, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_nhm_corei_sse2_1t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_nhm_corei_sse2_1t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_nhm_corei_sse2_1t;"
+        "_work_done_nhm_corei_sse2_1t:"
         "movq %%r14, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -1653,10 +1665,16 @@ int asm_work_nhm_corei_sse2_2t(threaddata_t* threaddata) __attribute__((noinline
 int asm_work_nhm_corei_sse2_2t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -1672,12 +1690,14 @@ int asm_work_nhm_corei_sse2_2t(threaddata_t* threaddata)
          *   - r12:      stores cacheline width as increment for buffer addresses
          *   - r13:      stores address of shared variable that controls load level
          *   - r14:      stores iteration counter
+         *   - r15:      stores number of iterations left in this call
          *   - mm*,xmm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize SSE-Registers for Addition
         "movapd 0(%%rax), %%xmm0;"
@@ -1703,14 +1723,14 @@ int asm_work_nhm_corei_sse2_2t(threaddata_t* threaddata)
         "pinsrq $1, %%r11, %%xmm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $131072, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $786432, %%rdi;" // address for RAM-buffer
-        "movabs $0, %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $0, %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $81920, %%r10;" // reset-counter for RAM-buffer with 10 cache lines accessed per loop (51200.0 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 10 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_nhm_corei_sse2_2t:"
@@ -2449,18 +2469,22 @@ int asm_work_nhm_corei_sse2_2t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_nhm_corei_sse2_2t;"
-        "movabs $81920, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $786432, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_nhm_corei_sse2_2t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_nhm_corei_sse2_2t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_nhm_corei_sse2_2t;"
+        "_work_done_nhm_corei_sse2_2t:"
         "movq %%r14, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -2473,10 +2497,16 @@ int asm_work_nhm_xeonep_sse2_1t(threaddata_t* threaddata) __attribute__((noinlin
 int asm_work_nhm_xeonep_sse2_1t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -2492,12 +2522,14 @@ int asm_work_nhm_xeonep_sse2_1t(threaddata_t* threaddata)
          *   - r12:      stores cacheline width as increment for buffer addresses
          *   - r13:      stores address of shared variable that controls load level
          *   - r14:      stores iteration counter
+         *   - r15:      stores number of iterations left in this call
          *   - mm*,xmm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize SSE-Registers for Addition
         "movapd 0(%%rax), %%xmm0;"
@@ -2523,14 +2555,14 @@ int asm_work_nhm_xeonep_sse2_1t(threaddata_t* threaddata)
         "pinsrq $1, %%r11, %%xmm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $32768, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $262144, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $2097152, %%rdi;" // address for RAM-buffer
-        "movabs $0, %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $0, %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $68266, %%r10;" // reset-counter for RAM-buffer with 24 cache lines accessed per loop (102399.0 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 24 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_nhm_xeonep_sse2_1t:"
@@ -4051,18 +4083,22 @@ int asm_work_nhm_xeonep_sse2_1t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_nhm_xeonep_sse2_1t;"
-        "movabs $68266, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $2097152, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_nhm_xeonep_sse2_1t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_nhm_xeonep_sse2_1t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_nhm_xeonep_sse2_1t;"
+        "_work_done_nhm_xeonep_sse2_1t:"
         "movq %%r14, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
@@ -4075,10 +4111,16 @@ int asm_work_nhm_xeonep_sse2_2t(threaddata_t* threaddata) __attribute__((noinlin
 int asm_work_nhm_xeonep_sse2_2t(threaddata_t* threaddata)
 {
     if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;
+    unsigned long long chunk = threaddata->chunk;
+    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];
+    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];
         /* input: 
          *   - threaddata->addrMem    -> rax
          *   - threaddata->addrHigh   -> rbx
          *   - threaddata->iterations -> rcx
+         *   - threaddata->chunk      -> rdx
+         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers
+         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers
          * output: 
          *   - rax -> threaddata->iterations
          * register usage:
@@ -4094,12 +4136,14 @@ int asm_work_nhm_xeonep_sse2_2t(threaddata_t* threaddata)
          *   - r12:      stores cacheline width as increment for buffer addresses
          *   - r13:      stores address of shared variable that controls load level
          *   - r14:      stores iteration counter
+         *   - r15:      stores number of iterations left in this call
          *   - mm*,xmm*: data registers for SIMD instructions
          */
         __asm__ __volatile__(
         "mov %%rax, %%rax;" // store start address of buffer in rax
         "mov %%rbx, %%r13;" // store address of shared variable that controls load level in r13
         "mov %%rcx, %%r14;" // store iteration counter in r14
+        "mov %%rdx, %%r15;" // store number of iterations for this call in r15
         "mov $64, %%r12;" // increment after each cache/memory access
         //Initialize SSE-Registers for Addition
         "movapd 0(%%rax), %%xmm0;"
@@ -4125,14 +4169,14 @@ int asm_work_nhm_xeonep_sse2_2t(threaddata_t* threaddata)
         "pinsrq $1, %%r11, %%xmm15;"
         "mov %%rax, %%rbx;" // address for L1-buffer
         "mov %%rax, %%rcx;"
-        "add $16384, %%rcx;" // address for L2-buffer
+        "add %[l1_size], %%rcx;" // address for L2-buffer
         "mov %%rax, %%rdx;"
-        "add $131072, %%rdx;" // address for L3-buffer
+        "add %[l2_size], %%rdx;" // address for L3-buffer
         "mov %%rax, %%rdi;"
-        "add $1048576, %%rdi;" // address for RAM-buffer
-        "movabs $0, %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $0, %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop (0.0 KB)
-        "movabs $68266, %%r10;" // reset-counter for RAM-buffer with 12 cache lines accessed per loop (51199.5 KB)
+        "add %[l3_size], %%rdi;" // address for RAM-buffer
+        "mov %[l2_count], %%r8;" // reset-counter for L2-buffer with 0 cache lines accessed per loop
+        "mov %[l3_count], %%r9;" // reset-counter for L3-buffer with 0 cache lines accessed per loop
+        "mov %[ram_count], %%r10;" // reset-counter for RAM-buffer with 12 cache lines accessed per loop
 
         ".align 64;"     /* alignment in bytes */
         "_work_loop_nhm_xeonep_sse2_2t:"
@@ -4897,18 +4941,22 @@ int asm_work_nhm_xeonep_sse2_2t(threaddata_t* threaddata)
         //reset RAM counter
         "sub $1, %%r10;"
         "jnz _work_no_ram_reset_nhm_xeonep_sse2_2t;"
-        "movabs $68266, %%r10;"
+        "mov %[ram_count], %%r10;"
         "mov %%rax, %%rdi;"
-        "add $1048576, %%rdi;"
+        "add %[l3_size], %%rdi;"
         "_work_no_ram_reset_nhm_xeonep_sse2_2t:"
         "inc %%r14;" // increment iteration counter
         "mov %%rax, %%rbx;"
+        "sub $1, %%r15;" // decrement number of iterations left in this call
+        "jz _work_done_nhm_xeonep_sse2_2t;"
         "testq $1, (%%r13);"
         "jnz _work_loop_nhm_xeonep_sse2_2t;"
+        "_work_done_nhm_xeonep_sse2_2t:"
         "movq %%r14, %%rax;" // restore iteration counter
-        : "=a" (threaddata->iterations)
-        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations)
-        : "%rdx", "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+        : "=a" (threaddata->iterations), "+d" (chunk)
+        : "a"(threaddata->addrMem), "b"(threaddata->addrHigh), "c" (threaddata->iterations),
+          [l1_size] "m" (l1_size), [l2_size] "m" (l2_size), [l3_size] "m" (l3_size), [l2_count] "m" (l2_count), [l3_count] "m" (l3_count), [ram_count] "m" (ram_count)
+        : "%rdi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15", "%mm0", "%mm1", "%mm2", "%mm3", "%mm4", "%mm5", "%mm6", "%mm7", "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
         );
     return EXIT_SUCCESS;
 }
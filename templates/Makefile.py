@@ -28,7 +28,7 @@ def src_obj_files(file,templates,version):
     src_files_win = ''
     obj_files_win = ''
     for each in templates:
-        src_files = each.file+'.c '+src_files
+        src_files = each.file+'.S '+src_files
         obj_files = each.file+'.o '+obj_files
         if each.win64_incl == 1:
             src_files_win = each.file+'.c '+src_files_win
@@ -44,8 +44,8 @@ def template_rules(file,templates,version):
         flags = ''
         for flag in each.flags:
             flags = flag+' '+flags
-        file.write(each.file+".o: "+each.file+".c\n")
-        file.write("\t${LINUX_CC} ${OPT_ASM} ${LINUX_C_FLAGS} "+flags+" -c "+each.file+".c\n\n")
+        file.write(each.file+".o: "+each.file+".S asm_offsets.h\n")
+        file.write("\t${LINUX_CC} ${OPT_STD} ${LINUX_C_FLAGS} -c "+each.file+".S\n\n")
         if (version.enable_win64 == 1) and (each.win64_incl == 1):
             file.write(each.file+"_win64.o: "+each.file+".c\n")
             file.write("\t${WIN64_CC} ${OPT_ASM} ${WIN64_C_FLAGS} "+flags+" -c "+each.file+".c -o "+each.file+"_win64.o\n\n")
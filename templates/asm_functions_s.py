@@ -0,0 +1,164 @@
+###############################################################################
+# FIRESTARTER - A Processor Stress Test Utility
+# Copyright (C) 2017 TU Dresden, Center for Information Services and High
+# Performance Computing
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Contact: daniel.hackenberg@tu-dresden.de
+###############################################################################
+
+# converts the inline assembler of the generated <isa>_functions.c into <isa>_functions.S
+# - System V calling convention: threaddata in rdi, EXIT_SUCCESS in eax, callee-saved registers are restored
+# - threaddata_t is accessed through the offsets in asm_offsets.h
+# - the registers are loaded with the same values as the input operands of the inline assembler
+#   (rax: addrMem, rbx: addrHigh, rcx: iterations, rdx: chunk), threaddata is kept in rbp
+# - the vector registers are cleared at the start and stored to threaddata->results at the end,
+#   they are checked by --verify
+# - the Windows build still uses the inline assembler, as the Win64 calling convention differs
+
+import re
+
+header = '''/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+/*
+ * generated from {0}, do not edit
+ * int asm_work_*(threaddata_t* threaddata), see asm_offsets.h for the accessed fields
+ */
+
+#include "asm_offsets.h"
+
+        .text
+'''
+
+prologue = '''        .globl  {0}
+        .type   {0}, @function
+        .p2align 4
+{0}:
+        push %rbp
+        push %rbx
+        push %r12
+        push %r13
+        push %r14
+        push %r15
+        mov %rdi, %rbp                  /* threaddata */
+        mov TD_ADDRHIGH(%rbp), %rbx
+        cmpq $0, (%rbx)                 /* nothing to do if the load level is low */
+        je _work_return_{1}
+        mov TD_ADDRMEM(%rbp), %rax
+        mov TD_ITERATIONS(%rbp), %rcx
+        mov TD_CHUNK(%rbp), %rdx
+{2}'''
+
+epilogue = '''        mov %rax, TD_ITERATIONS(%rbp)
+{2}        emms                            /* leave MMX state for the x87 FPU */
+_work_return_{1}:
+        xor %eax, %eax                  /* EXIT_SUCCESS */
+        pop %r15
+        pop %r14
+        pop %r13
+        pop %r12
+        pop %rbx
+        pop %rbp
+        ret
+        .size   {0}, .-{0}
+
+'''
+
+# memory operands of the inline assembler and the threaddata_t fields they are copied from
+operands = [('%5', 'TD_SHIFT_SEED(%rbp)'),
+            ('%[l1_size]', 'TD_BUFFERSIZE(%rbp)'),
+            ('%[l2_size]', 'TD_BUFFERSIZE+8(%rbp)'),
+            ('%[l3_size]', 'TD_BUFFERSIZE+16(%rbp)'),
+            ('%[l2_count]', 'TD_RESET_COUNT(%rbp)'),
+            ('%[l3_count]', 'TD_RESET_COUNT+8(%rbp)'),
+            ('%[ram_count]', 'TD_RESET_COUNT+16(%rbp)')]
+
+def convert_line(line):
+    # one line of the asm statement: string literals become code, // comments become C comments
+    stripped = line.strip()
+    if not stripped.startswith('"'):
+        if stripped.startswith('//'):
+            text = stripped.lstrip('/').strip()
+            return '        /* '+text+' */' if text else ''
+        return line
+    code = ''.join(re.findall(r'"([^"]*)"', stripped))
+    rest = stripped[stripped.rindex('"')+1:].strip()
+    for operand, field in operands:
+        code = code.replace(operand, field)
+    code = code.replace('%%', '%')
+    if rest.startswith('//'):
+        rest = '/* '+rest[2:].strip()+' */'
+    return ('        '+code+'  '+rest).rstrip()
+
+def avx512(name, func):
+    # payloads that use the zmm registers: the AVX512 file and the 512 bit, INT8 (VNNI), and BF16 variants
+    return name.startswith('avx512') or any(v in func for v in ('_w512_', '_int8_', '_bf16_'))
+
+def clear_registers(name, func):
+    # some payloads accumulate into registers they do not load (e.g. ymm14/15), they start from zero,
+    # vzeroall does not clear zmm16-31
+    if name.startswith('sse2'):
+        return ''.join('        pxor %xmm{0}, %xmm{0}\n'.format(i) for i in range(16))
+    if avx512(name, func):
+        return '        vzeroall\n'+''.join('        vpxord %zmm{0}, %zmm{0}, %zmm{0}\n'.format(i) for i in range(16, 32))
+    return '        vzeroall\n'
+
+def store_results(name, func):
+    # the vector registers are stored to threaddata->results, the SSE2 payloads use the xmm registers only,
+    # the AVX512 payloads all 32 zmm registers
+    if name.startswith('sse2'):
+        return ''.join('        movdqu %xmm{0}, TD_RESULTS+{1}(%rbp)\n'.format(i, 16*i) for i in range(16))
+    if avx512(name, func):
+        return ''.join('        vmovdqu64 %zmm{0}, TD_RESULTS+{1}(%rbp)\n'.format(i, 64*i) for i in range(32))
+    return ''.join('        vmovdqu %ymm{0}, TD_RESULTS+{1}(%rbp)\n'.format(i, 32*i) for i in range(16))
+
+def convert(source, dest, name):
+    text = open(source).read()
+    out = open(dest, 'w')
+    out.write(header.format(name))
+    for match in re.finditer(r'(/\*\*\n(?: \*[^\n]*\n)*)(?://[^\n]*\n)*int (asm_work_\w+)\(threaddata_t\* threaddata\) __attribute__\(\(noinline\)\);\nint \2\(threaddata_t\* threaddata\)\n\{\n(.*?)\n\}', text, re.S):
+        doc, func, body = match.group(1), match.group(2), match.group(3)
+        lines = body.split('\n')
+        start = [i for i, l in enumerate(lines) if '__asm__ __volatile__(' in l][0]
+        end = [i for i, l in enumerate(lines) if i > start and l.strip().startswith(':')][0]
+        comment = [l for l in lines[:start] if l.strip().startswith('/*') or l.strip().startswith('*')]
+        out.write(doc)
+        out.write(prologue.format(func, func[len('asm_work_'):], clear_registers(name, func)))
+        for l in comment:
+            out.write(l+'\n')
+        for l in lines[start+1:end]:
+            out.write(convert_line(l)+'\n')
+        out.write(epilogue.format(func, func[len('asm_work_'):], store_results(name, func)))
+    out.write('        .section .note.GNU-stack,"",@progbits\n')
+    out.close()
@@ -20,9 +20,29 @@
 ###############################################################################
 
 from __future__ import division
-import sys
+import sys, re
 from . import util
 
+# instructions of the supported data types: FMA replacement, move, and operations per instruction relative to vfmadd231pd
+datatypes = {
+    'dp':    ['vfmadd231pd', 'vmovapd', 1],
+    'sp':    ['vfmadd231ps', 'vmovaps', 2], # 8 single precision FMAs per 256 bit
+    'int16': ['vpmaddwd',    'vmovdqa', 3], # 16 multiplications and 8 additions per 256 bit
+    'int8':  ['vpdpbusd',    'vmovdqa', 8], # 32 multiplications and 32 additions per 256 bit
+    'bf16':  ['vdpbf16ps',   'vmovaps', 4], # 16 multiplications and 16 additions per 256 bit
+}
+
+def simd(inst,each):
+    # adapt an instruction of the 256 bit double precision code to the SIMD width and data type of the function
+    inst = inst.replace('vfmadd231pd',datatypes[each.datatype][0]).replace('vmovapd',datatypes[each.datatype][1])
+    if each.width == 128:
+        return inst.replace('%%ymm','%%xmm')
+    if each.width == 512:
+        # align the memory operands to cache lines, as zmm accesses cover full cache lines
+        inst = re.sub(r'(\d+)\(%%', lambda m: str(int(m.group(1))//64*64)+'(%%', inst)
+        return inst.replace('%%ymm','%%zmm')
+    return inst
+
 def init_functions(file,architectures):
     isa='fma'
     for each in architectures:
@@ -39,16 +59,23 @@ def init_functions(file,architectures):
                     file.write("int init_"+func_name+"(threaddata_t* threaddata)\n")
                     file.write("{\n")
                     file.write("    unsigned long long addrMem = threaddata->addrMem;\n")
-                    file.write("    int i;\n")
+                    file.write("    unsigned long long buffersize = threaddata->buffersize[0] + threaddata->buffersize[1] + threaddata->buffersize[2] + threaddata->buffersize[3];\n")
+                    file.write("    unsigned long long i;\n")
                     file.write("\n")
 # old version: one large loop that initializes indivisual elements
 #                    buffersize = (l1_size+l2_size+l3_size+ram_size) // 8
 #                    file.write("    // for (i = 0; i<"+str(buffersize)+"; i++) ((double*)addrMem)[i] = 0.25 + (double)(i%9267) * 0.24738995982e-4;\n")
 #                    file.write("    for (i = 0; i<"+str(buffersize)+"; i++) ((double*)addrMem)[i] = 0.25 + (double)(i&0x1FFF) * 0.27948995982e-4;\n")
-                    buffersize = (l1_size+l2_size+l3_size+ram_size)
-                    file.write("    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;\n")
-                    file.write("    for (i = INIT_BLOCKSIZE; i <= "+str(buffersize)+" - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);\n")
-                    file.write("    for (; i <= "+str(buffersize)+"-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;\n")
+                    buffersize = 'buffersize'
+                    if each.datatype in ('sp','bf16'):
+                        # single precision values, the upper halves are also valid bf16 values
+                        file.write("    for (i = 0; i < INIT_BLOCKSIZE; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;\n")
+                        file.write("    for (i = INIT_BLOCKSIZE; i <= "+str(buffersize)+" - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);\n")
+                        file.write("    for (; i <= "+str(buffersize)+"-4; i+=4) *((float*)(addrMem+i)) = 0.25f + (float)i * 0.27948995982e-4f;\n")
+                    else:
+                        file.write("    for (i = 0; i < INIT_BLOCKSIZE; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;\n")
+                        file.write("    for (i = INIT_BLOCKSIZE; i <= "+str(buffersize)+" - INIT_BLOCKSIZE; i+= INIT_BLOCKSIZE) memcpy((void*)(addrMem+i),(void*)(addrMem+i-INIT_BLOCKSIZE),INIT_BLOCKSIZE);\n")
+                        file.write("    for (; i <= "+str(buffersize)+"-8; i+=8) *((double*)(addrMem+i)) = 0.25 + (double)i * 0.27948995982e-4;\n")
                     file.write("\n")
                     flops_total=0
                     bytes_total=0
@@ -110,9 +137,14 @@ def init_functions(file,architectures):
                         bytes_total+=bytes*int(each.proportion[i])
                     repeat= lines // sequence_length
                     flops_total*=repeat
+                    flops_total=flops_total*each.width//256*datatypes[each.datatype][2]
                     bytes_total*=repeat
                     file.write("    threaddata->flops="+str(flops_total)+";\n")
                     file.write("    threaddata->bytes="+str(bytes_total)+";\n")
+                    sequence = util.generate_sequence(each.instr_groups,each.proportion)
+                    file.write("    threaddata->reset_count[0] = buffer_reset_count(threaddata->buffersize[1], "+str(each.l2_cover)+", "+str(util.repeat(sequence,lines)*util.l2_seq_count(sequence))+");\n")
+                    file.write("    threaddata->reset_count[1] = buffer_reset_count(threaddata->buffersize[2], "+str(each.l3_cover)+", "+str(util.repeat(sequence,lines)*util.l3_seq_count(sequence))+");\n")
+                    file.write("    threaddata->reset_count[2] = buffer_reset_count(threaddata->buffersize[3], "+str(each.ram_cover)+", "+str(util.repeat(sequence,lines)*util.ram_seq_count(sequence))+");\n")
                     file.write("\n")
                     file.write("    return EXIT_SUCCESS;\n")
                     file.write("}\n")
@@ -133,6 +165,7 @@ def work_functions(file,architectures,version):
     offset_reg      = 'r14'
     addrHigh_reg    = 'r15'
     iter_reg        = 'mm0'
+    chunk_reg       = 'mm1'
     shift_reg       = ['rdi','rsi','rdx']
     shift_reg32     = ['edi','esi','edx']
     nr_shift_regs   = 3
@@ -145,7 +178,8 @@ def work_functions(file,architectures,version):
     shift_regs_clob='\"%'+shift_reg[0]+'\"'
     for i in range(1,nr_shift_regs):
         shift_regs = shift_regs+','+shift_reg[i]
-        shift_regs_clob = shift_regs_clob+', \"%'+shift_reg[i]+'\"'
+        if shift_reg[i] != 'rdx': # rdx is an in/output operand
+            shift_regs_clob = shift_regs_clob+', \"%'+shift_reg[i]+'\"'
 
     for each in architectures:
         for item in each.isa:
@@ -167,10 +201,17 @@ def work_functions(file,architectures,version):
                     file.write("int asm_work_"+func_name+"(threaddata_t* threaddata)\n")
                     file.write("{\n")
                     file.write("    if (*((unsigned long long*)threaddata->addrHigh) == 0) return EXIT_SUCCESS;\n")
+                    file.write("    unsigned long long chunk = threaddata->chunk;\n")
+                    file.write("    unsigned long long l1_size = threaddata->buffersize[0], l2_size = threaddata->buffersize[1], l3_size = threaddata->buffersize[2];\n")
+                    file.write("    unsigned long long l2_count = threaddata->reset_count[0], l3_count = threaddata->reset_count[1], ram_count = threaddata->reset_count[2];\n")
+                    file.write("    unsigned int shift_seed = threaddata->shift_seed;\n")
                     file.write("        /* input: \n")
                     file.write("         *   - threaddata->addrMem    -> rax\n")
                     file.write("         *   - threaddata->addrHigh   -> rbx\n")
                     file.write("         *   - threaddata->iterations -> rcx\n")
+                    file.write("         *   - threaddata->chunk      -> rdx\n")
+                    file.write("         *   - threaddata->buffersize  -> offsets of the L2, L3, and RAM pointers\n")
+                    file.write("         *   - threaddata->reset_count -> reset counters of the L2, L3, and RAM pointers\n")
                     file.write("         * output: \n")
                     file.write("         *   - rax -> threaddata->iterations\n")
                     file.write("         * register usage:\n")
@@ -186,6 +227,7 @@ def work_functions(file,architectures,version):
                     file.write("         *   - {:<12} stores cacheline width as increment for buffer addresses\n".format(offset_reg+":"))
                     file.write("         *   - {:<12} stores address of shared variable that controls load level\n".format(addrHigh_reg+":"))
                     file.write("         *   - {:<12} stores iteration counter\n".format(iter_reg+":"))
+                    file.write("         *   - {:<12} stores number of iterations left in this call\n".format(chunk_reg+":"))
                     file.write("         *   - {:<12} registers for shift operations\n".format(shift_regs+":"))
                     file.write("         *   - {:<12} data registers for SIMD instructions\n".format("xmm*,ymm*:"))
                     # file.write("         *\n")
@@ -196,29 +238,30 @@ def work_functions(file,architectures,version):
                     file.write("        \"mov %%rax, %%"+pointer_reg+";\" // store start address of buffer in "+pointer_reg+"\n")
                     file.write("        \"mov %%rbx, %%"+addrHigh_reg+";\" // store address of shared variable that controls load level in "+addrHigh_reg+"\n")
                     file.write("        \"movq %%rcx, %%"+iter_reg+";\" // store iteration counter in "+iter_reg+"\n")
+                    file.write("        \"movq %%rdx, %%"+chunk_reg+";\" // store number of iterations for this call in "+chunk_reg+"\n")
                     file.write("        \"mov $64, %%"+offset_reg+";\" // increment after each cache/memory access\n")
                     file.write("        //Initialize registers for shift operations\n")
                     for i in range(0,nr_shift_regs):
-                        file.write("        \"mov $0xAAAAAAAA, %%"+shift_reg32[i]+";\"\n")
+                        file.write("        \"mov %5, %%"+shift_reg32[i]+";\"\n")
                     file.write("        //Initialize AVX-Registers for FMA Operations\n")
-                    file.write("        \"vmovapd (%%rax), %%ymm0;\"\n")
-                    file.write("        \"vmovapd (%%rax), %%ymm1;\"\n")
+                    file.write("        \""+simd("vmovapd (%%rax), %%ymm0;",each)+"\"\n")
+                    file.write("        \""+simd("vmovapd (%%rax), %%ymm1;",each)+"\"\n")
                     add_start = mul_regs
                     add_end   = mul_regs + add_regs - 1
                     trans_start = add_regs + mul_regs
                     trans_end = mul_regs + add_regs + alt_dst_regs - 1
                     for i in range(add_start,trans_end+1):
-                        file.write("        \"vmovapd "+str(256+i*32)+"(%%rax), %%ymm"+str(i)+";\"\n")
+                        file.write("        \""+simd("vmovapd "+str(256+i*32)+"(%%rax), %%ymm"+str(i)+";",each)+"\"\n")
                     file.write("        \"mov %%"+pointer_reg+", %%"+l1_addr+";\" // address for L1-buffer\n")
                     file.write("        \"mov %%"+pointer_reg+", %%"+l2_addr+";\"\n")
-                    file.write("        \"add $"+str(l1_size)+", %%"+l2_addr+";\" // address for L2-buffer\n")
+                    file.write("        \"add %[l1_size], %%"+l2_addr+";\" // address for L2-buffer\n")
                     file.write("        \"mov %%"+pointer_reg+", %%"+l3_addr+";\"\n")
-                    file.write("        \"add $"+str(l2_size)+", %%"+l3_addr+";\" // address for L3-buffer\n")
+                    file.write("        \"add %[l2_size], %%"+l3_addr+";\" // address for L3-buffer\n")
                     file.write("        \"mov %%"+pointer_reg+", %%"+ram_addr+";\"\n")
-                    file.write("        \"add $"+str(l3_size)+", %%"+ram_addr+";\" // address for RAM-buffer\n")
-                    file.write("        \"movabs $"+str(util.l2_loop_count(each,threads,sequence))+", %%"+l2_count_reg+";\" // reset-counter for L2-buffer with "+str(util.repeat(sequence,lines)*util.l2_seq_count(sequence))+" cache lines accessed per loop ("+str(round((util.l2_accesses(each,threads,sequence)*each.cl_size)/1024,2))+" KB)\n")
-                    file.write("        \"movabs $"+str(util.l3_loop_count(each,threads,sequence))+", %%"+l3_count_reg+";\" // reset-counter for L3-buffer with "+str(util.repeat(sequence,lines)*util.l3_seq_count(sequence))+" cache lines accessed per loop ("+str(round((util.l3_accesses(each,threads,sequence)*each.cl_size)/1024,2))+" KB)\n")
-                    file.write("        \"movabs $"+str(util.ram_loop_count(each,threads,sequence))+", %%"+ram_count_reg+";\" // reset-counter for RAM-buffer with "+str(util.repeat(sequence,lines)*util.ram_seq_count(sequence))+" cache lines accessed per loop ("+str(round((util.ram_accesses(each,threads,sequence)*each.cl_size)/1024,2))+" KB)\n")
+                    file.write("        \"add %[l3_size], %%"+ram_addr+";\" // address for RAM-buffer\n")
+                    file.write("        \"mov %[l2_count], %%"+l2_count_reg+";\" // reset-counter for L2-buffer with "+str(util.repeat(sequence,lines)*util.l2_seq_count(sequence))+" cache lines accessed per loop\n")
+                    file.write("        \"mov %[l3_count], %%"+l3_count_reg+";\" // reset-counter for L3-buffer with "+str(util.repeat(sequence,lines)*util.l3_seq_count(sequence))+" cache lines accessed per loop\n")
+                    file.write("        \"mov %[ram_count], %%"+ram_count_reg+";\" // reset-counter for RAM-buffer with "+str(util.repeat(sequence,lines)*util.ram_seq_count(sequence))+" cache lines accessed per loop\n")
                     file.write("\n")
                     if version.enable_mac == 1:
                         file.write("        #ifdef __MACH__ /* Mac OS compatibility */\n")
@@ -388,6 +431,9 @@ def work_functions(file,architectures,version):
                                     d2_inst = 'shr $1, %%'+str(shift_reg32[shift_pos])+';'
                                 else:
                                     d2_inst = 'shl $1, %%'+str(shift_reg32[shift_pos])+';'
+                            d0_inst = simd(d0_inst,each)
+                            d1_inst = simd(d1_inst,each)
+                            d2_inst = simd(d2_inst,each)
                             # write instruction group to file
                             file.write("        \"{:<40} {:<40} {:<20} {:<20}\" {:<}\n".format(d0_inst, d1_inst, d2_inst, d3_inst, comment))
                             # prepare register numbers for next iteration
@@ -413,35 +459,43 @@ def work_functions(file,architectures,version):
                         file.write("        //reset RAM counter\n")
                         file.write("        \"sub $1, %%"+ram_count_reg+";\"\n")
                         file.write("        \"jnz _work_no_ram_reset_"+func_name+";\"\n")
-                        file.write("        \"movabs $"+str(util.ram_loop_count(each,threads,sequence))+", %%"+ram_count_reg+";\"\n")
+                        file.write("        \"mov %[ram_count], %%"+ram_count_reg+";\"\n")
                         file.write("        \"mov %%"+pointer_reg+", %%"+ram_addr+";\"\n")
-                        file.write("        \"add $"+str(l3_size)+", %%"+ram_addr+";\"\n")
+                        file.write("        \"add %[l3_size], %%"+ram_addr+";\"\n")
                         file.write("        \"_work_no_ram_reset_"+func_name+":\"\n")
                     file.write("        \"inc %%"+temp_reg+";\" // increment iteration counter\n")
                     if util.l2_seq_count(sequence) > 0:
                         file.write("        //reset L2-Cache counter\n")
                         file.write("        \"sub $1, %%"+l2_count_reg+";\"\n")
                         file.write("        \"jnz _work_no_L2_reset_"+func_name+";\"\n")
-                        file.write("        \"movabs $"+str(util.l2_loop_count(each,threads,sequence))+", %%"+l2_count_reg+";\"\n")
+                        file.write("        \"mov %[l2_count], %%"+l2_count_reg+";\"\n")
                         file.write("        \"mov %%"+pointer_reg+", %%"+l2_addr+";\"\n")
-                        file.write("        \"add $"+str(l1_size)+", %%"+l2_addr+";\"\n")
+                        file.write("        \"add %[l1_size], %%"+l2_addr+";\"\n")
                         file.write("        \"_work_no_L2_reset_"+func_name+":\"\n")
                     file.write("        \"movq %%"+temp_reg+", %%"+iter_reg+";\" // store iteration counter\n")
                     if util.l3_seq_count(sequence) > 0:
                         file.write("        //reset L3-Cache counter\n")
                         file.write("        \"sub $1, %%"+l3_count_reg+";\"\n")
                         file.write("        \"jnz _work_no_L3_reset_"+func_name+";\"\n")
-                        file.write("        \"movabs $"+str(util.l3_loop_count(each,threads,sequence))+", %%"+l3_count_reg+";\"\n")
+                        file.write("        \"mov %[l3_count], %%"+l3_count_reg+";\"\n")
                         file.write("        \"mov %%"+pointer_reg+", %%"+l3_addr+";\"\n")
-                        file.write("        \"add $"+str(l2_size)+", %%"+l3_addr+";\"\n")
+                        file.write("        \"add %[l2_size], %%"+l3_addr+";\"\n")
                         file.write("        \"_work_no_L3_reset_"+func_name+":\"\n")
                     file.write("        \"mov %%"+pointer_reg+", %%"+l1_addr+";\"\n")
                     #file.write("        \"mfence;\"\n")
+                    file.write("        \"movq %%"+chunk_reg+", %%"+temp_reg+";\" // decrement number of iterations left in this call\n")
+                    file.write("        \"sub $1, %%"+temp_reg+";\"\n")
+                    file.write("        \"movq %%"+temp_reg+", %%"+chunk_reg+";\"\n")
+                    file.write("        \"jz _work_done_"+func_name+";\"\n")
                     file.write("        \"testq $1, (%%"+addrHigh_reg+");\"\n")
                     file.write("        \"jnz _work_loop_"+func_name+";\"\n")
+                    file.write("        \"_work_done_"+func_name+":\"\n")
+                    if each.width == 512:
+                        file.write("        \"vzeroupper;\" // avoid penalties of SSE code after the function\n")
                     file.write("        \"movq %%"+iter_reg+", %%rax;\" // restore iteration counter\n")
-                    file.write("        : \"=a\" (threaddata->iterations)\n")
-                    file.write("        : \"a\"(threaddata->addrMem), \"b\"(threaddata->addrHigh), \"c\" (threaddata->iterations)\n")
+                    file.write("        : \"=a\" (threaddata->iterations), \"+d\" (chunk)\n")
+                    file.write("        : \"a\"(threaddata->addrMem), \"b\"(threaddata->addrHigh), \"c\" (threaddata->iterations), \"m\" (shift_seed),\n")
+                    file.write("          [l1_size] \"m\" (l1_size), [l2_size] \"m\" (l2_size), [l3_size] \"m\" (l3_size), [l2_count] \"m\" (l2_count), [l3_count] \"m\" (l3_count), [ram_count] \"m\" (ram_count)\n")
                     file.write("        : \"%"+l3_addr+"\", \"%"+ram_addr+"\", \"%"+l2_count_reg+"\", \"%"+l3_count_reg+"\", \"%"+ram_count_reg+"\", \"%"+temp_reg+"\", \"%"+offset_reg+"\", \"%"+addrHigh_reg+"\", "+shift_regs_clob+", \"%mm0\", \"%mm1\", \"%mm2\", \"%mm3\", \"%mm4\", \"%mm5\", \"%mm6\", \"%mm7\", \"%xmm0\", \"%xmm1\", \"%xmm2\", \"%xmm3\", \"%xmm4\", \"%xmm5\", \"%xmm6\", \"%xmm7\", \"%xmm8\", \"%xmm9\", \"%xmm10\", \"%xmm11\", \"%xmm12\", \"%xmm13\", \"%xmm14\", \"%xmm15\"\n")
                     file.write("        );\n")
                     file.write("    return EXIT_SUCCESS;\n")
@@ -26,7 +26,8 @@ def list_functions(file,architectures):
             for threads in each.threads:
                 id = id + 1
                 func_name = 'FUNC_'+each.arch+'_'+each.model+'_'+isa+'_'+threads+'T'
-                file.write("  if (feature_available(\""+isa.upper()+"\")) printf(\"  %4.4s | %.30s | yes\\n\",\""+str(id)+"\",\""+func_name.upper()+"                             \");\n")
+                feature = (each.feature or isa).upper()
+                file.write("  if (feature_available(\""+feature+"\")) printf(\"  %4.4s | %.30s | yes\\n\",\""+str(id)+"\",\""+func_name.upper()+"                             \");\n")
                 file.write("  else printf(\"  %4.4s | %.30s | no\\n\",\""+str(id)+"\",\""+func_name.upper()+"                             \");\n")
 
 def get_function_cases(file,architectures):
@@ -36,10 +37,11 @@ def get_function_cases(file,architectures):
             for threads in each.threads:
                 id = id + 1
                 func_name = 'FUNC_'+each.arch+'_'+each.model+'_'+isa+'_'+threads+'T'
+                feature = (each.feature or isa).upper()
                 file.write("       case "+str(id)+":\n")
-                file.write("         if (feature_available(\""+isa.upper()+"\")) func = "+func_name.upper()+";\n")
+                file.write("         if (feature_available(\""+feature+"\")) func = "+func_name.upper()+";\n")
                 file.write("         else{\n")
-                file.write("           fprintf(stderr, \"\\nError: Function "+str(id)+" (\\\""+func_name.upper()+"\\\") requires "+isa.upper()+", which is not supported by the processor.\\n\\n\");\n")
+                file.write("           fprintf(stderr, \"\\nError: Function "+str(id)+" (\\\""+func_name.upper()+"\\\") requires "+feature+", which is not supported by the processor.\\n\\n\");\n")
                 file.write("         }\n")
                 file.write("         break;\n")
 
@@ -105,11 +107,9 @@ def evaluate_environment_set_buffersize(file,architectures):
                 file.write("        BUFFERSIZE[2] = "+str(size)+";\n")
                 size = int(each.ram_size) // int(threads)
                 file.write("        RAMBUFFERSIZE = "+str(size)+";\n")
+                file.write("        threads = "+threads+";\n")
                 file.write("        if (verbose) {\n")
                 file.write("            printf(\"\\n  Taking "+isa.upper()+" path optimized for "+each.name+" - "+threads+" thread(s) per core\");\n")
-                file.write("            printf(\"\\n  Used buffersizes per thread:\\n\");\n")
-                file.write("            for (i = 0; i < MAX_CACHELEVELS; i++) if (BUFFERSIZE[i] > 0) printf(\"    - L%d-Cache: %d Bytes\\n\", i + 1, BUFFERSIZE[i]);\n")
-                file.write("            printf(\"    - Memory: %llu Bytes\\n\\n\", RAMBUFFERSIZE);\n")
                 file.write("        }\n")
                 file.write("        break;\n")
 
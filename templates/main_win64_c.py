@@ -28,7 +28,7 @@ def list_functions(file,architectures,templates):
                     for threads in each.threads:
                         id = id + 1
                         func_name = 'func_'+each.arch+'_'+each.model+'_'+isa+'_'+threads+'T'
-                        file.write("    if (has_feature("+tmpl.feature_req.upper().replace('.','_')+")) printf(\"  %4.4s | %.30s | yes\\n\",\""+str(id)+"\",\""+func_name.upper()+"                             \");\n")
+                        file.write("    if (has_feature("+(each.feature or tmpl.feature_req).upper().replace('.','_')+")) printf(\"  %4.4s | %.30s | yes\\n\",\""+str(id)+"\",\""+func_name.upper()+"                             \");\n")
                         file.write("    else printf(\"  %4.4s | %.30s | no \\n\",\""+str(id)+"\",\""+func_name.upper()+"                             \");\n")
 
 def get_function_cases(file,architectures,templates):
@@ -59,6 +59,10 @@ def WorkerThread_select_function(file,architectures,templates):
                         if (int(threads) == 4):
                             file.write("      p = _mm_malloc(3351552*8,4096);\n")
                         file.write("      data->addrMem = (unsigned long long) p;\n")
+                        file.write("      data->buffersize[0] = "+str(int(each.l1_size) // int(threads))+";\n")
+                        file.write("      data->buffersize[1] = "+str(int(each.l2_size) // int(threads))+";\n")
+                        file.write("      data->buffersize[2] = "+str(int(each.l3_size) // int(threads))+";\n")
+                        file.write("      data->buffersize[3] = "+str(int(each.ram_size) // int(threads))+";\n")
                         file.write("      init_"+func_name+"(data);\n")
                         file.write("      while(*((unsigned long long*)(data->addrHigh)) != LOAD_STOP){\n")
                         file.write("        asm_work_"+func_name+"(data);\n")
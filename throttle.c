@@ -0,0 +1,133 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#include "firestarter_global.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "throttle.h"
+#include "msrio.h"
+
+#define TURBO_LIMIT 0x1AD
+#define PERF_LOG 0x690
+
+static const char *reason_names[THROTTLE_REASONS] = {
+    [THROTTLE_PROCHOT] = "PROCHOT",
+    [THROTTLE_THERMAL] = "thermal",
+    [THROTTLE_RESIDENCY] = "residency state regulation",
+    [THROTTLE_RATL] = "running average thermal limit",
+    [THROTTLE_VR_THERMAL] = "VR thermal alert",
+    [THROTTLE_VR_CURRENT] = "VR current (EDP)",
+    [THROTTLE_OTHER] = "other",
+    [THROTTLE_PL1] = "power limit PL1",
+    [THROTTLE_PL2] = "power limit PL2",
+    [THROTTLE_MAX_TURBO] = "max turbo limit",
+    [THROTTLE_ATTENUATION] = "turbo transition attenuation",
+};
+
+void throttle_start(threaddata_t *mydata)
+{
+    uint64_t turbo_limit = 0;
+
+    msrio_read(mydata->cpu_id, TURBO_LIMIT, &turbo_limit);
+    memset(&mydata->throttle, 0, sizeof(throttle_t));
+    mydata->throttle.turbo_limit = turbo_limit;
+    mydata->throttle.cores = 1;
+    // the log bits are cleared by writing 0, the status bits are read-only
+    msrio_write(mydata->cpu_id, PERF_LOG, 0);
+}
+
+void throttle_sample(threaddata_t *mydata, msrdata_t *sample, unsigned long long tsc, uint64_t aperf, uint64_t mperf)
+{
+    throttle_t *throttle = &mydata->throttle;
+    uint64_t reasons = 0, limits;
+    unsigned int r, n;
+    double ghz, limit;
+
+    msrio_read(mydata->cpu_id, PERF_LOG, &reasons);
+    if (reasons >> 16) msrio_write(mydata->cpu_id, PERF_LOG, 0);
+    limits = (reasons | (reasons >> 16)) & 0xFFFF;
+    sample->limits = limits;
+
+    throttle->tsc += tsc;
+    if (limits) throttle->limited_tsc += tsc;
+    for (r = 0; r < THROTTLE_REASONS; r++) {
+        if (limits & (1UL << r)) throttle->reason_tsc[r] += tsc;
+    }
+
+    // TURBO_RATIO_LIMIT holds the maximal ratio for 1 to 8 active cores, more cores use the one of 8
+    n = (throttle->cores > THROTTLE_MAX_CORES) ? THROTTLE_MAX_CORES : throttle->cores;
+    if ((n == 0) || (mperf == 0) || (throttle->turbo_limit == 0)) return;
+    ghz = (double) aperf / (double) mperf * mydata->config->maxfreq;
+    limit = (double) ((throttle->turbo_limit >> (8 * (n - 1))) & 0xFF) * 0.1;
+    throttle->cores_tsc[n - 1] += tsc;
+    throttle->ghz_tsc[n - 1] += ghz * (double) tsc;
+    if (ghz < limit - THROTTLE_TOLERANCE * 0.1) {
+        throttle->below_tsc[n - 1] += tsc;
+        if (limits == 0) throttle->unexplained_tsc[n - 1] += tsc;
+    }
+}
+
+void throttle_report(FILE *stream, const threaddata_t *threads, unsigned int num_threads, unsigned long long clockrate)
+{
+    unsigned long long tsc = 0, limited = 0, reason[THROTTLE_REASONS], cores, below, unexplained;
+    double ghz;
+    unsigned int r, n, t;
+
+    memset(reason, 0, sizeof(reason));
+    for (t = 0; t < num_threads; t++) {
+        tsc += threads[t].throttle.tsc;
+        limited += threads[t].throttle.limited_tsc;
+        for (r = 0; r < THROTTLE_REASONS; r++) reason[r] += threads[t].throttle.reason_tsc[r];
+    }
+    if (tsc == 0) return;
+
+    fprintf(stream, "\nlimit reasons (sampled time of all threads: %.3f s):\n", (double) tsc / (double) clockrate);
+    for (r = 0; r < THROTTLE_REASONS; r++) {
+        if (reason[r] == 0) continue;
+        if (reason_names[r]) fprintf(stream, "  %-30s", reason_names[r]);
+        else fprintf(stream, "  bit %-26u", r);
+        fprintf(stream, " %10.3f s  %6.2f%%\n", (double) reason[r] / (double) clockrate, 100.0 * (double) reason[r] / (double) tsc);
+    }
+    fprintf(stream, "  %-30s %10.3f s  %6.2f%%\n", "any", (double) limited / (double) clockrate, 100.0 * (double) limited / (double) tsc);
+
+    if (threads[0].throttle.turbo_limit == 0) {
+        fprintf(stream, "frequency vs. turbo limit: TURBO_RATIO_LIMIT is not available\n");
+        return;
+    }
+    fprintf(stream, "frequency vs. turbo limit (TURBO_RATIO_LIMIT):\n");
+    for (n = 0; n < THROTTLE_MAX_CORES; n++) {
+        cores = below = unexplained = 0;
+        ghz = 0.0;
+        for (t = 0; t < num_threads; t++) {
+            cores += threads[t].throttle.cores_tsc[n];
+            below += threads[t].throttle.below_tsc[n];
+            unexplained += threads[t].throttle.unexplained_tsc[n];
+            ghz += threads[t].throttle.ghz_tsc[n];
+        }
+        if (cores == 0) continue;
+        // below the limit without a reason: the AVX license or a limit that the processor does not report
+        fprintf(stream, "  %u%s active cores: limit %.2f GHz, observed %.3f GHz, %.2f%% of the time below the limit, %.2f%% of it without a reason\n",
+            n + 1, (n + 1 == THROTTLE_MAX_CORES) ? " or more" : "",
+            (double) ((threads[0].throttle.turbo_limit >> (8 * n)) & 0xFF) * 0.1, ghz / (double) cores,
+            100.0 * (double) below / (double) cores, below ? 100.0 * (double) unexplained / (double) below : 0.0);
+    }
+}
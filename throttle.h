@@ -0,0 +1,93 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__THROTTLE_H
+#define __FIRESTARTER__THROTTLE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * limit reasons of CORE_PERF_LIMIT_REASONS (0x690, bits 15:0 status, bits 31:16 log) as documented for the
+ * client processors since Skylake, each sample records the reasons that were active or logged during it
+ * and clears the log bits, the other models use the same bits for most of the reasons
+ */
+#define THROTTLE_PROCHOT       0
+#define THROTTLE_THERMAL       1
+#define THROTTLE_RESIDENCY     4
+#define THROTTLE_RATL          5
+#define THROTTLE_VR_THERMAL    6
+#define THROTTLE_VR_CURRENT    7
+#define THROTTLE_OTHER         8
+#define THROTTLE_PL1           10
+#define THROTTLE_PL2           11
+#define THROTTLE_MAX_TURBO     12
+#define THROTTLE_ATTENUATION   13
+
+/*
+ * number of status bits of CORE_PERF_LIMIT_REASONS and of active core counts in TURBO_RATIO_LIMIT (one byte each)
+ */
+#define THROTTLE_REASONS       16
+#define THROTTLE_MAX_CORES     8
+
+/*
+ * a sample is below the turbo limit if its frequency is lower by more than this fraction of a ratio step (100 MHz)
+ */
+#define THROTTLE_TOLERANCE     0.5
+
+/* limit reasons and frequency of a thread, part of threaddata_t */
+typedef struct throttle
+{
+   uint64_t turbo_limit;            /* TURBO_RATIO_LIMIT: maximal ratio for 1 to 8 active cores */
+   unsigned int cores;              /* active cores of the package in the current step */
+   unsigned long long tsc;          /* sampled cycles, ... */
+   unsigned long long limited_tsc;  /* ... the ones with any limit reason, ... */
+   unsigned long long reason_tsc[THROTTLE_REASONS]; /* ... and the ones with each reason */
+   unsigned long long cores_tsc[THROTTLE_MAX_CORES];       /* sampled cycles per number of active cores, ... */
+   unsigned long long below_tsc[THROTTLE_MAX_CORES];       /* ... the ones below the turbo limit, ... */
+   unsigned long long unexplained_tsc[THROTTLE_MAX_CORES]; /* ... and the ones below it without a reason */
+   double ghz_tsc[THROTTLE_MAX_CORES];                     /* frequency weighted with the cycles */
+} throttle_t;
+
+/* firestarter_global.h includes this header before it defines the thread data */
+struct threaddata;
+struct msrdata;
+
+/*
+ * reads TURBO_RATIO_LIMIT, clears the log bits of the limit reasons, and resets the statistics of the thread,
+ * called at the start of each run
+ */
+extern void throttle_start(struct threaddata *mydata);
+
+/*
+ * reads the limit reasons after a sample of tsc cycles with the given APERF and MPERF deltas, stores them in
+ * sample->limits, and adds the cycles to the reasons and to the comparison with the turbo limit of
+ * mydata->throttle.cores active cores
+ */
+extern void throttle_sample(struct threaddata *mydata, struct msrdata *sample, unsigned long long tsc, uint64_t aperf, uint64_t mperf);
+
+/*
+ * prints the time that the threads spent limited by each reason, and their frequency next to the turbo limit
+ * of each number of active cores, to stream
+ */
+extern void throttle_report(FILE *stream, const struct threaddata *threads, unsigned int num_threads, unsigned long long clockrate);
+
+#endif
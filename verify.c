@@ -0,0 +1,92 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include "verify.h"
+#include "pattern.h"
+#include "work.h"
+
+/*
+ * FNV-1a on 64 bit words
+ */
+static unsigned long long fold(unsigned long long checksum, const unsigned long long *words, unsigned long long n)
+{
+    unsigned long long i;
+
+    for (i = 0; i < n; i++) checksum = (checksum ^ words[i]) * 0x100000001B3ULL;
+    return checksum;
+}
+
+unsigned long long verify_checksum(threaddata_t *threaddata)
+{
+    threaddata_t run;
+    unsigned long long load = LOAD_HIGH, checksum = 0xCBF29CE484222325ULL;
+
+    memset(&run, 0, sizeof(run));
+    run.FUNCTION = threaddata->verify_function;
+    run.data_pattern = threaddata->data_pattern;
+    run.alignment = threaddata->alignment;
+    run.data = threaddata->data;
+
+    /* the same buffer layout, data, and shift registers on every CPU: the pattern of thread 0 */
+    run.buffersize[0] = threaddata->buffersize[0];
+    run.buffersize[1] = threaddata->buffersize[1];
+    run.buffersize[2] = threaddata->buffersize[1];
+    run.buffersize[3] = VERIFY_RAM_SIZE;
+    run.buffersizeMem = 2 * run.buffersize[0] + run.buffersize[1] + run.buffersize[2] + run.buffersize[3] +
+                        run.alignment + 2 * sizeof(unsigned long long);
+    run.shift_seed = data_pattern_shift_seed(run.data_pattern, 0);
+    if (threaddata->verifyMem == NULL) threaddata->verifyMem = _mm_malloc(run.buffersizeMem, run.alignment);
+    if (threaddata->verifyMem == NULL) {
+        fprintf(stderr, "Error: --verify: allocation of the verification buffer failed\n");
+        exit(127);
+    }
+    run.bufferMem = threaddata->verifyMem;
+    run.addrMem = (unsigned long long)run.bufferMem;
+    run.addrHigh = (unsigned long long)&load;
+    run.chunk = VERIFY_ITERATIONS;
+
+    call_init(&run);
+    if (run.data_pattern != PATTERN_DEFAULT) fill_data_pattern(&run);
+    call_asm_work(&run);
+
+    checksum = fold(checksum, &run.iterations, 1);
+    checksum = fold(checksum, run.results, sizeof(run.results) / sizeof(run.results[0]));
+    return fold(checksum, (unsigned long long *)run.addrMem, run.buffersize[0] / sizeof(unsigned long long));
+}
+
+void verify_payload(threaddata_t *threaddata)
+{
+    unsigned long long start = timestamp(), checksum;
+
+    checksum = verify_checksum(threaddata);
+    threaddata->verify_checks++;
+    if (checksum != threaddata->data->verify_reference) {
+        threaddata->verify_errors++;
+        fprintf(stderr, "Error: --verify: wrong payload result on CPU %u (checksum %016llx, expected %016llx)\n",
+                threaddata->cpu_id, checksum, threaddata->data->verify_reference);
+    }
+    threaddata->verify_next = timestamp() + threaddata->verify_tsc;
+    threaddata->verify_cycles += threaddata->verify_next - threaddata->verify_tsc - start;
+}
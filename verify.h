@@ -0,0 +1,53 @@
+/******************************************************************************
+ * FIRESTARTER - A Processor Stress Test Utility
+ * Copyright (C) 2017 TU Dresden, Center for Information Services and High
+ * Performance Computing
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact: daniel.hackenberg@tu-dresden.de
+ *****************************************************************************/
+
+#ifndef __FIRESTARTER__VERIFY_H
+#define __FIRESTARTER__VERIFY_H
+
+#include "firestarter_global.h"
+
+/*
+ * --verify: default time between two verifications of the payload results in ms
+ */
+#define VERIFY_MS              1000
+
+/*
+ * payload iterations of a verification run and the L3 and RAM part of its private buffer,
+ * L1 and L2 have the size of the payload buffer
+ */
+#define VERIFY_ITERATIONS      1000
+#define VERIFY_RAM_SIZE        1048576
+
+/*
+ * runs the payload threaddata->verify_function for VERIFY_ITERATIONS iterations on freshly initialized data in
+ * threaddata->verifyMem (allocated on first use) and returns a checksum of the vector registers and the L1 part
+ * of the buffer, the result is the same on every CPU for a given function, buffer size, and data pattern
+ */
+extern unsigned long long verify_checksum(threaddata_t *threaddata);
+
+/*
+ * compares verify_checksum() with threaddata->data->verify_reference, reports a mismatch with the CPU of the
+ * thread, and schedules the next verification threaddata->verify_tsc cycles later
+ */
+extern void verify_payload(threaddata_t *threaddata);
+
+#endif
+
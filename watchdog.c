@@ -21,10 +21,94 @@
 
 #include "firestarter_global.h"
 #include "watchdog.h"
+#include "powercap.h"
+#include "msrio.h"
+#include <string.h>
+#include <math.h>
+
+#define ENERGY_UNIT 0x606
 
 extern unsigned long long LOADVAR;
 int TERMINATE = 0;
 
+/*
+ * --target-watts: state of the PID controller
+ */
+typedef struct target {
+    double unit;                    /* energy unit in J */
+    uint64_t energy[MAX_PACKAGES];  /* ENERGY_STATUS at the start of the period */
+    struct timespec last;
+    double share;                   /* actuator: share of high load per period */
+    double integral, error;
+    double sum_watts, sum_error;    /* statistics of the run */
+    unsigned long periods;
+    FILE *trace;
+} target_t;
+
+static void target_init(watchdog_arg_t *arg, target_t *target)
+{
+    uint64_t unit = 0;
+
+    msrio_read(0, ENERGY_UNIT, &unit);
+    memset(target, 0, sizeof(target_t));
+    target->unit = 1.0 / (double) (1UL << ((unit >> 8) & 0x1F));
+    target->share = (double) arg->load / (double) arg->period;
+    // the controller starts from the share of -l
+    if (arg->ki > 0.0) target->integral = target->share / arg->ki;
+    target->trace = fopen(TARGET_TRACE, "w");
+    if (target->trace == NULL) fprintf(stderr, "Error: cannot write %s\n", TARGET_TRACE);
+    else fprintf(target->trace, "time\tsetpoint\tpower\tload\n");
+    powercap_energy(arg->packages, target->energy);
+    clock_gettime(CLOCK_REALTIME, &target->last);
+}
+
+/*
+ * measures the power of the last period and returns the high load time of the next one
+ */
+static long long target_update(watchdog_arg_t *arg, target_t *target, struct timespec *start_ts, long long period)
+{
+    uint64_t energy[MAX_PACKAGES];
+    struct timespec now;
+    double joules = 0.0, dt, watts, error, share;
+    unsigned int p;
+
+    powercap_energy(arg->packages, energy);
+    clock_gettime(CLOCK_REALTIME, &now);
+    dt = (double) (now.tv_sec - target->last.tv_sec) + (double) (now.tv_nsec - target->last.tv_nsec) * 0.000000001;
+    if (dt <= 0.0) return (long long) (target->share * (double) period);
+    // ENERGY_STATUS is a 32 bit counter
+    for (p = 0; p < arg->packages; p++) joules += (double) ((energy[p] - target->energy[p]) & 0xFFFFFFFFUL) * target->unit;
+    watts = joules / dt;
+
+    error = (arg->target_watts - watts) / arg->target_watts;
+    share = arg->kp * error + arg->ki * (target->integral + error * dt) + arg->kd * (error - target->error) / dt;
+    // anti-windup: the integral only grows while the actuator is not saturated
+    if ((share > 0.0) && (share < 1.0)) target->integral += error * dt;
+    else share = (share < 0.0) ? 0.0 : 1.0;
+    target->error = error;
+    target->share = share;
+    target->sum_watts += watts;
+    target->sum_error += fabs(arg->target_watts - watts);
+    target->periods++;
+    if (target->trace) {
+        fprintf(target->trace, "%.3f\t%.2f\t%.2f\t%.4f\n",
+                (double) (now.tv_sec - start_ts->tv_sec) + (double) (now.tv_nsec - start_ts->tv_nsec) * 0.000000001,
+                arg->target_watts, watts, share);
+    }
+    memcpy(target->energy, energy, sizeof(energy));
+    target->last = now;
+
+    return (long long) (share * (double) period);
+}
+
+static void target_finish(watchdog_arg_t *arg, target_t *target)
+{
+    if (target->trace) fclose(target->trace);
+    if (target->periods == 0) return;
+    printf("\npower target: %.2f W, measured: %.2f W on average, mean deviation: %.2f W, trace in %s\n", arg->target_watts,
+           target->sum_watts / (double) target->periods, target->sum_error / (double) target->periods, TARGET_TRACE);
+}
+
 /* signal load changes to workers */
 static void set_load(unsigned long long *loadvar, unsigned long long value)
 {
@@ -55,6 +139,7 @@ void *watchdog_timer(watchdog_arg_t *arg)
     unsigned long long *loadvar;
     struct timespec start_ts, current;
     int sleepret;
+    target_t target;
 
     sigemptyset(&signal_mask);
     sigaddset(&signal_mask, SIGINT);
@@ -68,6 +153,7 @@ void *watchdog_timer(watchdog_arg_t *arg)
     loadvar = arg->loadvar;
 
 
+    if (arg->target_watts > 0.0) target_init(arg, &target);
     clock_gettime(CLOCK_REALTIME, &start_ts);
     time = 0;
     /* TODO: I don't like that the control flow depends on the period variable,
@@ -117,6 +203,12 @@ void *watchdog_timer(watchdog_arg_t *arg)
         SCOREP_USER_REGION_BY_NAME_END("WD_LOW");
 #endif
 
+        /* --target-watts: the PID controller sets the high load share of the next period */
+        if (arg->target_watts > 0.0) {
+            load = target_update(arg, &target, &start_ts, period);
+            idle = period - load;
+        }
+
         /* signal high load */
         set_load(loadvar, LOAD_HIGH);
         
@@ -124,9 +216,10 @@ void *watchdog_timer(watchdog_arg_t *arg)
 
         /* exit when termination signal is received or timeout is reached */
         //if( (TERMINATE) || ((timeout > 0) && (time / 1000000 >= timeout)) ){
-        if( (TERMINATE) ){
+        if( (TERMINATE) || ((arg->target_watts > 0.0) && (timeout > 0) && (time / 1000000 >= timeout)) ){
             /* signal that the workers shall shout down */
             set_load(loadvar, LOAD_STOP);
+            if (arg->target_watts > 0.0) target_finish(arg, &target);
             return 0;
         }
     }
@@ -22,6 +22,16 @@
 #ifndef __FIRESTARTER__WATCHDOG__H
 #define __FIRESTARTER__WATCHDOG__H
 
+/*
+ * --target-watts: default gains of the PID controller (actuator: share of high load per period,
+ * error: deviation from the setpoint relative to the setpoint, integral in s, derivative in 1/s),
+ * the setpoint, measured power, and actuator value of every period are written to TARGET_TRACE
+ */
+#define TARGET_KP          0.5
+#define TARGET_KI          2.0
+#define TARGET_KD          0.0
+#define TARGET_TRACE       "powertarget.trace"
+
 void sigterm_handler();
 void *watchdog_timer(watchdog_arg_t *arg);
 
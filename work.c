@@ -20,8 +20,6 @@
  *****************************************************************************/
 
 //#define MCK 1
-//#define NUM_FS_WORKLOADS 6
-//#define NUM_SLEEP_WORKLOADS 2
 
 #define _GNU_SOURCE
 
@@ -34,6 +32,7 @@
 #include <pthread.h>
 #include <math.h>
 #include <time.h>
+#include <stddef.h>
 
 #ifdef ENABLE_VTRACING
 #include <vt_user.h>
@@ -61,7 +60,6 @@
 #define THERM_CORE 0x19C
 #define FIXED_CTR_CTRL 0x38D
 
-#define NUM_ITERS 80000UL
 #define DUTY_CYCLE 8800U
 #define QUARTER_DUTY (DUTY_CYCLE / 4)
 #define FIXED_CTR_CTL 0x38D
@@ -70,62 +68,132 @@
  */
 #include "work.h"
 #include "cpu.h"
+#include "secondary.h"
+#include "pattern.h"
+#include "verify.h"
+#include "powercap.h"
+#include "phases.h"
+#include "throttle.h"
+#include "msrio.h"
+#include "asm_offsets.h"
+
+/*
+ * the assembler implementations in *_functions.S access threaddata_t through the offsets in asm_offsets.h
+ */
+typedef char check_td_addrMem[(offsetof(threaddata_t, addrMem) == TD_ADDRMEM) ? 1 : -1];
+typedef char check_td_addrHigh[(offsetof(threaddata_t, addrHigh) == TD_ADDRHIGH) ? 1 : -1];
+typedef char check_td_iterations[(offsetof(threaddata_t, iterations) == TD_ITERATIONS) ? 1 : -1];
+typedef char check_td_chunk[(offsetof(threaddata_t, chunk) == TD_CHUNK) ? 1 : -1];
+typedef char check_td_shift_seed[(offsetof(threaddata_t, shift_seed) == TD_SHIFT_SEED) ? 1 : -1];
+typedef char check_td_buffersize[(offsetof(threaddata_t, buffersize) == TD_BUFFERSIZE) ? 1 : -1];
+typedef char check_td_reset_count[(offsetof(threaddata_t, reset_count) == TD_RESET_COUNT) ? 1 : -1];
+typedef char check_td_results[(offsetof(threaddata_t, results) == TD_RESULTS) ? 1 : -1];
+typedef char check_td_results_size[(sizeof(((threaddata_t *) 0)->results) == TD_RESULTS_SIZE) ? 1 : -1];
 
 //#define ENERGY_UNIT (1.0f / 8.0f)
 #define MAX_JOULES (0xFFFFFFFFUL / 65536UL)
-#define WATTS 90.0 
-#define SECONDS 1
 
 int BARRIER_GLOBAL = 0;
 
-int intload();
+void disable_rapl()
+{
+	uint64_t rapl = 0x0;
+	#ifdef MCK
+	syscall(WRITE, POWER_LIMIT, &rapl);
+	#endif
+	#ifndef MCK
+	write_msr_by_coord(0, 0, 0, POWER_LIMIT, &rapl);
+	#endif
+}
 
-void set_rapl(unsigned sec, double watts, double pu, double su)
+/*
+ * --sweep: add the package energy and time of the open interval to the current function and open a new
+ * interval if open is set, called by the first thread when a payload step starts (open) and ends (!open),
+ * so the secondary steps in between are not attributed to any function
+ */
+void sweep_account_energy(threaddata_t *mydata, double energy_unit, int open)
 {
-	uint64_t power = (unsigned long) (watts / pu);
-	uint64_t seconds;
-	uint64_t timeval_y = 0, timeval_x = 0;
-	double logremainder = 0;
-
-	timeval_y = (uint64_t) log2(sec / su);
-	// store the mantissa of the log2
-	logremainder = (double) log2(sec / su) - (double) timeval_y;
-	timeval_x = 0;
-	// based on the mantissa, we can choose the appropriate multiplier
-	if (logremainder > 0.15 && logremainder <= 0.45)
+	uint64_t energy, low, high;
+	msrio_read(mydata->cpu_id, ENERGY_STATUS, &energy);
+	__asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
+
+	if (mydata->sweep_start)
 	{
-		timeval_x = 1;
+		// ENERGY_STATUS is a 32 bit counter
+		mydata->sweepdata[mydata->sweep_pos].joules += (double) ((energy - mydata->sweep_energy) & 0xFFFFFFFFUL) * energy_unit;
+		mydata->sweepdata[mydata->sweep_pos].wall_tsc += ((high << 32) | low) - mydata->sweep_start;
 	}
-	else if (logremainder > 0.45 && logremainder <= 0.7)
+	mydata->sweep_energy = energy;
+	mydata->sweep_start = open ? ((high << 32) | low) : 0;
+}
+
+/*
+ * --pstate-sweep: called by the first thread before the barrier of each sample, starts the measurement of the
+ * current ratio after PSTATE_SETTLE of the dwell and moves on to the next ratio when the dwell is over
+ */
+void pstate_advance(threaddata_t *mydata, double energy_unit)
+{
+	volatile mydata_t *data = mydata->data;
+	unsigned long long now = timestamp();
+	uint64_t energy;
+
+	if (data->pstate_current >= data->num_pstates) return;
+	if (!mydata->pstate_start && (now >= data->pstate_measure))
 	{
-		timeval_x = 2;
+		msrio_read(mydata->cpu_id, ENERGY_STATUS, &energy);
+		mydata->pstate_energy = energy;
+		mydata->pstate_start = now;
 	}
-	else if (logremainder > 0.7)
+	if (now < data->pstate_deadline) return;
+	if (mydata->pstate_start)
 	{
-		timeval_x = 3;
+		msrio_read(mydata->cpu_id, ENERGY_STATUS, &energy);
+		// ENERGY_STATUS is a 32 bit counter
+		mydata->pstatedata[data->pstate_current].joules = (double) ((energy - mydata->pstate_energy) & 0xFFFFFFFFUL) * energy_unit;
+		mydata->pstatedata[data->pstate_current].wall_tsc = now - mydata->pstate_start;
+		mydata->pstate_start = 0;
 	}
-	// store the bits in the Intel specified format
-	seconds = (uint64_t) (timeval_y | (timeval_x << 5));
-	uint64_t rapl = 0x0 | power | (seconds << 17);
+	data->pstate_measure = now + (unsigned long long) (PSTATE_SETTLE * (double) data->dwell_tsc);
+	data->pstate_deadline = now + data->dwell_tsc;
+	data->pstate_current++;
+}
 
-	rapl |= (1LL << 15) | (1LL << 16);
-	#ifdef MCK
-	syscall(WRITE, POWER_LIMIT, &rapl);
-	#endif
-	#ifndef MCK
-	write_msr_by_coord(0, affinity, thread, POWER_LIMIT, &rapl);
-	#endif
+/*
+ * writes target to bits 15:0 of PERF_CTL of the own CPU, the turbo disengage bit follows the run configuration,
+ * the value before the first write is saved for perf_restore()
+ */
+void perf_set(threaddata_t *mydata, uint64_t target)
+{
+	uint64_t perf = 0;
+
+	msrio_read(mydata->cpu_id, PERF_CTL, &perf);
+	if (!mydata->perf_saved_valid)
+	{
+		mydata->perf_saved = perf;
+		mydata->perf_saved_valid = 1;
+	}
+	perf = (perf & 0xFFFFFFFEFFFF0000UL) | (target & 0xFFFFUL);
+	if (!mydata->config->turbo) perf |= 0x100000000UL;
+	msrio_write(mydata->cpu_id, PERF_CTL, perf);
 }
 
-void disable_rapl()
+/*
+ * restores PERF_CTL of the own CPU to the value before perf_set()
+ */
+void perf_restore(threaddata_t *mydata)
 {
-	uint64_t rapl = 0x0;
-	#ifdef MCK
-	syscall(WRITE, POWER_LIMIT, &rapl);
-	#endif
-	#ifndef MCK
-	write_msr_by_coord(0, 0, 0, POWER_LIMIT, &rapl);
-	#endif
+	if (!mydata->perf_saved_valid) return;
+	msrio_write(mydata->cpu_id, PERF_CTL, mydata->perf_saved);
+	mydata->perf_saved_valid = 0;
+}
+
+/*
+ * --pstate-sweep: writes the current ratio to PERF_CTL (bits 15:8)
+ */
+void pstate_switch(threaddata_t *mydata)
+{
+	mydata->pstate_pos = mydata->data->pstate_current;
+	perf_set(mydata, (uint64_t) mydata->data->pstates[mydata->pstate_pos] << 8);
 }
 
 void barrier(unsigned affinity, threaddata_t *threaddata)
@@ -143,6 +211,204 @@ void barrier(unsigned affinity, threaddata_t *threaddata)
 	}
 }
 
+/*
+ * phase sequence: 1 if the thread runs step
+ */
+static int phase_active(const threaddata_t *mydata, const phase_step_t *step)
+{
+	return (step->workload != PHASE_IDLE) && (!step->active || step->active[mydata->thread_id]);
+}
+
+/*
+ * phase sequence: threads that do not run the current step wait here for its end,
+ * returns -1 if the master signals the end of the run
+ */
+static int phase_wait(threaddata_t *mydata, const phase_step_t *step)
+{
+	volatile mydata_t *data = mydata->data;
+
+	while (!data->phase_stop)
+	{
+		if (*((volatile unsigned long long *)(mydata->addrHigh)) == LOAD_STOP) return -1;
+		if (step->seconds > 0.0)
+		{
+			if (timestamp() >= mydata->phase_deadline) break;
+		}
+		else if (step->samples && (data->phase_arrived >= mydata->phase_arrivals)) break;
+		usleep(PHASE_IDLE_US);
+	}
+
+	return 0;
+}
+
+/*
+ * phase sequence: packages whose energy is logged
+ */
+static unsigned int phase_packages(const threaddata_t *mydata)
+{
+	unsigned int packages = mydata->data->cpuinfo->num_packages;
+
+	if (packages > MAX_PACKAGES) packages = MAX_PACKAGES;
+	return packages ? packages : 1;
+}
+
+/*
+ * phase sequence: logs the energy of all packages and the work of all threads at the start of step (num_steps = end
+ * of the run), the energy and time since the previous transition are added to the phase of the previous step,
+ * first thread only
+ */
+static void phase_log(threaddata_t *mydata, const phase_seq_t *seq, unsigned int step, double energy_unit)
+{
+	volatile mydata_t *data = mydata->data;
+	unsigned int packages = phase_packages(mydata), p, kind = NUM_PHASES;
+	uint64_t energy[MAX_PACKAGES];
+	unsigned long long tsc;
+	double joules = 0.0, delta;
+	phase_log_t *log;
+
+	powercap_energy(packages, energy);
+	tsc = timestamp();
+	if (mydata->phase_log_num == 0)
+	{
+		memset(mydata->phase_joules, 0, sizeof(mydata->phase_joules));
+		memset(mydata->phase_wall, 0, sizeof(mydata->phase_wall));
+	}
+	else
+	{
+		log = &mydata->phase_log[mydata->phase_log_num - 1];
+		// idle steps belong to neither phase
+		if ((log->step < seq->num_steps) && (seq->steps[log->step].workload != PHASE_IDLE))
+		{
+			kind = seq->steps[log->step].workload ? PHASE_SECONDARY : PHASE_PAYLOAD;
+			mydata->phase_wall[kind] += tsc - log->tsc;
+		}
+		for (p = 0; p < packages; p++)
+		{
+			// ENERGY_STATUS is a 32 bit counter
+			delta = (double) ((energy[p] - mydata->phase_energy[p]) & 0xFFFFFFFFUL) * energy_unit;
+			if (kind < NUM_PHASES) mydata->phase_joules[p][kind] += delta;
+			joules += delta;
+		}
+		joules += log->joules;
+	}
+	memcpy(mydata->phase_energy, energy, packages * sizeof(uint64_t));
+	if (mydata->phase_log_num == mydata->phase_log_max)
+	{
+		log = realloc(mydata->phase_log, (mydata->phase_log_max ? 2 * mydata->phase_log_max : 1024) * sizeof(phase_log_t));
+		if (log == NULL) return;
+		mydata->phase_log = log;
+		mydata->phase_log_max = mydata->phase_log_max ? 2 * mydata->phase_log_max : 1024;
+	}
+	log = &mydata->phase_log[mydata->phase_log_num++];
+	log->tsc = tsc;
+	log->joules = joules;
+	log->step = step;
+	log->samples = data->phase_samples_sum;
+	log->iterations = data->phase_iterations_sum;
+	log->flops = data->phase_flops_sum;
+	log->bytes = data->phase_bytes_sum;
+}
+
+/*
+ * phase sequence: cores of the package of this thread that run step, the turbo limit depends on them,
+ * the threads of a core are assumed to be placed next to each other
+ */
+static unsigned int phase_cores(const threaddata_t *mydata, const phase_step_t *step)
+{
+	const threaddata_t *threads = mydata->data->threaddata;
+	unsigned int smt = mydata->data->cpuinfo->num_threads_per_core, t, n = 0;
+
+	for (t = 0; t < mydata->data->num_threads; t++)
+	{
+		if ((threads[t].package == mydata->package) && (!step->active || step->active[t])) n++;
+	}
+	if (smt == 0) smt = 1;
+	return (n + smt - 1) / smt;
+}
+
+/*
+ * phase sequence: leaves the current step (first = none yet) and enters the next one that this thread runs,
+ * all threads pass the same transitions with two barriers each, in between phase_stop cannot change and
+ * the first thread applies the power limit and logs the transition, returns 1 if a step was entered,
+ * 0 at the end of the run, and -1 if the master signals the end of the run
+ */
+static int phase_transition(threaddata_t *mydata, const phase_seq_t *seq, int first, double power_unit, double time_unit,
+                            double energy_unit)
+{
+	volatile mydata_t *data = mydata->data;
+	const phase_step_t *step = first ? NULL : &seq->steps[mydata->phase_pc];
+	unsigned int affinity = mydata->cpu_id;
+	unsigned long long base, work, flops, bytes;
+	unsigned int kind;
+	uint64_t limit;
+	int end;
+
+	if (first) mydata->phase_timed = 0;
+	// the caps of the steps replace POWER_LIMIT until the end of the sequence
+	if (first && seq->caps && (mydata->thread_id == 0))
+	{
+		limit = 0;
+		msrio_read(affinity, POWER_LIMIT, &limit);
+		data->phase_limit = limit;
+	}
+	while (1)
+	{
+		if (step && phase_active(mydata, step))
+		{
+			// work of the step for the efficiency report, --sweep switches the function only after the transition
+			work = mydata->phase_iterations[PHASE_PAYLOAD] + mydata->phase_iterations[PHASE_SECONDARY] - mydata->phase_work_start;
+			kind = step->workload ? PHASE_SECONDARY : PHASE_PAYLOAD;
+			flops = work * (step->workload ? secondary_workloads[step->workload].flops : mydata->flops);
+			bytes = work * (step->workload ? secondary_workloads[step->workload].bytes : mydata->bytes);
+			mydata->efficiency_iterations[kind] += work;
+			mydata->efficiency_flops[kind] += flops;
+			mydata->efficiency_bytes[kind] += bytes;
+			__sync_fetch_and_add(&data->phase_samples_sum, mydata->phase_samples);
+			__sync_fetch_and_add(&data->phase_iterations_sum, work);
+			__sync_fetch_and_add(&data->phase_flops_sum, flops);
+			__sync_fetch_and_add(&data->phase_bytes_sum, bytes);
+			__sync_fetch_and_add(&data->phase_arrived, 1);
+		}
+		if (first) phases_first(seq, &mydata->phase_pc, mydata->phase_loops, &mydata->phase_depth);
+		else phases_next(seq, &mydata->phase_pc, mydata->phase_loops, &mydata->phase_depth);
+		first = 0;
+		barrier(affinity, mydata);
+		end = data->phase_stop || (mydata->phase_pc == seq->num_steps);
+		step = end ? NULL : &seq->steps[mydata->phase_pc];
+		if (mydata->thread_id == 0)
+		{
+			data->phase_start = timestamp();
+			if (seq->caps)
+			{
+				limit = step ? powercap_encode(step->cap, mydata->config->pl1_window, power_unit, time_unit) : data->phase_limit;
+				msrio_write(affinity, POWER_LIMIT, limit);
+			}
+			phase_log(mydata, seq, end ? seq->num_steps : mydata->phase_pc, energy_unit);
+		}
+		barrier(affinity, mydata);
+		if (end) return 0;
+
+		mydata->phase_samples = 0;
+		mydata->phase_work_start = mydata->phase_iterations[PHASE_PAYLOAD] + mydata->phase_iterations[PHASE_SECONDARY];
+		// the deadline is absolute: a timed step after a timed one starts at its deadline, not at the transition
+		if (step->seconds > 0.0)
+		{
+			base = mydata->phase_timed ? mydata->phase_deadline : data->phase_start;
+			mydata->phase_deadline = base + (unsigned long long) (step->seconds * (double) data->cpuinfo->clockrate);
+		}
+		mydata->phase_timed = (step->seconds > 0.0);
+		mydata->phase_arrivals += step->num_active;
+		if (phase_active(mydata, step))
+		{
+			if (seq->pstates) perf_set(mydata, step->pstate ? step->pstate : mydata->pstate);
+			mydata->throttle.cores = phase_cores(mydata, step);
+			if ((step->workload != 0) && (step->workload != PHASE_IDLE)) mydata->secondary = step->workload;
+			return 1;
+		}
+		if (phase_wait(mydata, step) < 0) return -1;
+	}
+}
+
 /*
  * low load function
  */
@@ -165,6 +431,292 @@ int low_load_function(volatile unsigned long long addrHigh, unsigned int period)
     return 0;
 }
 
+/*
+ * per thread share of the L1, L2, and L3 cache in bytes, derived from the detected cache sizes, the number of cores
+ * that share each cache, and the threads per core of the selected function (1T, 2T, 4T), levels that are not detected
+ * keep the given size
+ */
+void cache_buffersizes(cpu_info_t *cpuinfo, unsigned int threads, unsigned int *buffersize)
+{
+    unsigned long long size;
+    unsigned int i, shared, smt;
+
+    smt = cpuinfo->num_threads_per_core ? cpuinfo->num_threads_per_core : 1;
+    for (i = 0; i < MAX_CACHELEVELS; i++){
+        size = cpuinfo->Cache_unified[i] ? cpuinfo->U_Cache_Size[i] : cpuinfo->D_Cache_Size[i];
+        shared = cpuinfo->Cache_shared[i];
+        if ((shared == 0) || (shared > cpuinfo->num_cpus)){
+            /* sharing not reported: L1 and L2 belong to a core, L3 to a package */
+            if (i < 2) shared = smt;
+            else if (cpuinfo->num_packages) shared = cpuinfo->num_cpus / cpuinfo->num_packages;
+        }
+        if ((size == 0) || (shared == 0) || (shared > cpuinfo->num_cpus) || (threads == 0)) continue;
+        /* Cache_shared counts hardware threads, the function runs threads on each of the cores that share the cache */
+        shared = (shared + smt - 1) / smt * threads;
+        buffersize[i] = size / shared / 64 * 64;
+    }
+}
+
+/*
+ * call the init function selected for this thread
+ */
+int call_init(threaddata_t *mydata)
+{
+    switch (mydata->FUNCTION) {
+        case FUNC_KNL_XEONPHI_AVX512_4T:
+            return init_knl_xeonphi_avx512_4t(mydata);
+        case FUNC_SKL_COREI_FMA_1T:
+            return init_skl_corei_fma_1t(mydata);
+        case FUNC_SKL_COREI_FMA_2T:
+            return init_skl_corei_fma_2t(mydata);
+        case FUNC_HSW_COREI_FMA_1T:
+            return init_hsw_corei_fma_1t(mydata);
+        case FUNC_HSW_COREI_FMA_2T:
+            return init_hsw_corei_fma_2t(mydata);
+        case FUNC_HSW_XEONEP_FMA_1T:
+            return init_hsw_xeonep_fma_1t(mydata);
+        case FUNC_HSW_XEONEP_FMA_2T:
+            return init_hsw_xeonep_fma_2t(mydata);
+        case FUNC_SNB_COREI_AVX_1T:
+            return init_snb_corei_avx_1t(mydata);
+        case FUNC_SNB_COREI_AVX_2T:
+            return init_snb_corei_avx_2t(mydata);
+        case FUNC_SNB_XEONEP_AVX_1T:
+            return init_snb_xeonep_avx_1t(mydata);
+        case FUNC_SNB_XEONEP_AVX_2T:
+            return init_snb_xeonep_avx_2t(mydata);
+        case FUNC_NHM_COREI_SSE2_1T:
+            return init_nhm_corei_sse2_1t(mydata);
+        case FUNC_NHM_COREI_SSE2_2T:
+            return init_nhm_corei_sse2_2t(mydata);
+        case FUNC_NHM_XEONEP_SSE2_1T:
+            return init_nhm_xeonep_sse2_1t(mydata);
+        case FUNC_NHM_XEONEP_SSE2_2T:
+            return init_nhm_xeonep_sse2_2t(mydata);
+        case FUNC_BLD_OPTERON_FMA4_1T:
+            return init_bld_opteron_fma4_1t(mydata);
+        case FUNC_SKL_COREI_L1_FMA_1T:
+            return init_skl_corei_l1_fma_1t(mydata);
+        case FUNC_SKL_COREI_L1_FMA_2T:
+            return init_skl_corei_l1_fma_2t(mydata);
+        case FUNC_SKL_COREI_L2_FMA_1T:
+            return init_skl_corei_l2_fma_1t(mydata);
+        case FUNC_SKL_COREI_L2_FMA_2T:
+            return init_skl_corei_l2_fma_2t(mydata);
+        case FUNC_SKL_COREI_L3_FMA_1T:
+            return init_skl_corei_l3_fma_1t(mydata);
+        case FUNC_SKL_COREI_L3_FMA_2T:
+            return init_skl_corei_l3_fma_2t(mydata);
+        case FUNC_SKL_COREI_RAM_FMA_1T:
+            return init_skl_corei_ram_fma_1t(mydata);
+        case FUNC_SKL_COREI_RAM_FMA_2T:
+            return init_skl_corei_ram_fma_2t(mydata);
+        case FUNC_SKL_COREI_REG_FMA_1T:
+            return init_skl_corei_reg_fma_1t(mydata);
+        case FUNC_SKL_COREI_REG_FMA_2T:
+            return init_skl_corei_reg_fma_2t(mydata);
+        case FUNC_SKL_COREI_W128_FMA_1T:
+            return init_skl_corei_w128_fma_1t(mydata);
+        case FUNC_SKL_COREI_W128_FMA_2T:
+            return init_skl_corei_w128_fma_2t(mydata);
+        case FUNC_SKL_COREI_W512_FMA_1T:
+            return init_skl_corei_w512_fma_1t(mydata);
+        case FUNC_SKL_COREI_W512_FMA_2T:
+            return init_skl_corei_w512_fma_2t(mydata);
+        case FUNC_SKL_COREI_SP_FMA_1T:
+            return init_skl_corei_sp_fma_1t(mydata);
+        case FUNC_SKL_COREI_SP_FMA_2T:
+            return init_skl_corei_sp_fma_2t(mydata);
+        case FUNC_SKL_COREI_INT16_FMA_1T:
+            return init_skl_corei_int16_fma_1t(mydata);
+        case FUNC_SKL_COREI_INT16_FMA_2T:
+            return init_skl_corei_int16_fma_2t(mydata);
+        case FUNC_SKL_COREI_INT8_FMA_1T:
+            return init_skl_corei_int8_fma_1t(mydata);
+        case FUNC_SKL_COREI_INT8_FMA_2T:
+            return init_skl_corei_int8_fma_2t(mydata);
+        case FUNC_SKL_COREI_BF16_FMA_1T:
+            return init_skl_corei_bf16_fma_1t(mydata);
+        case FUNC_SKL_COREI_BF16_FMA_2T:
+            return init_skl_corei_bf16_fma_2t(mydata);
+        case FUNC_SKL_COREI_U288_FMA_1T:
+            return init_skl_corei_u288_fma_1t(mydata);
+        case FUNC_SKL_COREI_U288_FMA_2T:
+            return init_skl_corei_u288_fma_2t(mydata);
+        case FUNC_SKL_COREI_U576_FMA_1T:
+            return init_skl_corei_u576_fma_1t(mydata);
+        case FUNC_SKL_COREI_U576_FMA_2T:
+            return init_skl_corei_u576_fma_2t(mydata);
+        case FUNC_SKL_COREI_U1152_FMA_1T:
+            return init_skl_corei_u1152_fma_1t(mydata);
+        case FUNC_SKL_COREI_U1152_FMA_2T:
+            return init_skl_corei_u1152_fma_2t(mydata);
+        case FUNC_MEM_NTSTORE_SSE2:
+            return init_mem_ntstore_sse2(mydata);
+        case FUNC_MEM_READ_SSE2:
+            return init_mem_read_sse2(mydata);
+        case FUNC_MEM_COPY_SSE2:
+            return init_mem_copy_sse2(mydata);
+        case FUNC_MEM_TRIAD_SSE2:
+            return init_mem_triad_sse2(mydata);
+        case FUNC_COH_ATOMIC:
+            return init_coh_atomic(mydata);
+        case FUNC_COH_PINGPONG:
+            return init_coh_pingpong(mydata);
+        case FUNC_COH_QUEUE:
+            return init_coh_queue(mydata);
+        default:
+            fprintf(stderr, "Error: unknown function %i\n", mydata->FUNCTION);
+            return EXIT_FAILURE;
+    }
+}
+
+/*
+ * call the high load function selected for this thread
+ */
+int call_asm_work(threaddata_t *mydata)
+{
+    switch (mydata->FUNCTION)
+    {
+        case FUNC_KNL_XEONPHI_AVX512_4T:
+            return asm_work_knl_xeonphi_avx512_4t(mydata);
+        case FUNC_SKL_COREI_FMA_1T:
+            return asm_work_skl_corei_fma_1t(mydata);
+        case FUNC_SKL_COREI_FMA_2T:
+            return asm_work_skl_corei_fma_2t(mydata);
+        case FUNC_HSW_COREI_FMA_1T:
+            return asm_work_hsw_corei_fma_1t(mydata);
+        case FUNC_HSW_COREI_FMA_2T:
+            return asm_work_hsw_corei_fma_2t(mydata);
+        case FUNC_HSW_XEONEP_FMA_1T:
+            return asm_work_hsw_xeonep_fma_1t(mydata);
+        case FUNC_HSW_XEONEP_FMA_2T:
+            return asm_work_hsw_xeonep_fma_2t(mydata);
+        case FUNC_SNB_COREI_AVX_1T:
+            return asm_work_snb_corei_avx_1t(mydata);
+        case FUNC_SNB_COREI_AVX_2T:
+            return asm_work_snb_corei_avx_2t(mydata);
+        case FUNC_SNB_XEONEP_AVX_1T:
+            return asm_work_snb_xeonep_avx_1t(mydata);
+        case FUNC_SNB_XEONEP_AVX_2T:
+            return asm_work_snb_xeonep_avx_2t(mydata);
+        case FUNC_NHM_COREI_SSE2_1T:
+            return asm_work_nhm_corei_sse2_1t(mydata);
+        case FUNC_NHM_COREI_SSE2_2T:
+            return asm_work_nhm_corei_sse2_2t(mydata);
+        case FUNC_NHM_XEONEP_SSE2_1T:
+            return asm_work_nhm_xeonep_sse2_1t(mydata);
+        case FUNC_NHM_XEONEP_SSE2_2T:
+            return asm_work_nhm_xeonep_sse2_2t(mydata);
+        case FUNC_BLD_OPTERON_FMA4_1T:
+            return asm_work_bld_opteron_fma4_1t(mydata);
+        case FUNC_SKL_COREI_L1_FMA_1T:
+            return asm_work_skl_corei_l1_fma_1t(mydata);
+        case FUNC_SKL_COREI_L1_FMA_2T:
+            return asm_work_skl_corei_l1_fma_2t(mydata);
+        case FUNC_SKL_COREI_L2_FMA_1T:
+            return asm_work_skl_corei_l2_fma_1t(mydata);
+        case FUNC_SKL_COREI_L2_FMA_2T:
+            return asm_work_skl_corei_l2_fma_2t(mydata);
+        case FUNC_SKL_COREI_L3_FMA_1T:
+            return asm_work_skl_corei_l3_fma_1t(mydata);
+        case FUNC_SKL_COREI_L3_FMA_2T:
+            return asm_work_skl_corei_l3_fma_2t(mydata);
+        case FUNC_SKL_COREI_RAM_FMA_1T:
+            return asm_work_skl_corei_ram_fma_1t(mydata);
+        case FUNC_SKL_COREI_RAM_FMA_2T:
+            return asm_work_skl_corei_ram_fma_2t(mydata);
+        case FUNC_SKL_COREI_REG_FMA_1T:
+            return asm_work_skl_corei_reg_fma_1t(mydata);
+        case FUNC_SKL_COREI_REG_FMA_2T:
+            return asm_work_skl_corei_reg_fma_2t(mydata);
+        case FUNC_SKL_COREI_W128_FMA_1T:
+            return asm_work_skl_corei_w128_fma_1t(mydata);
+        case FUNC_SKL_COREI_W128_FMA_2T:
+            return asm_work_skl_corei_w128_fma_2t(mydata);
+        case FUNC_SKL_COREI_W512_FMA_1T:
+            return asm_work_skl_corei_w512_fma_1t(mydata);
+        case FUNC_SKL_COREI_W512_FMA_2T:
+            return asm_work_skl_corei_w512_fma_2t(mydata);
+        case FUNC_SKL_COREI_SP_FMA_1T:
+            return asm_work_skl_corei_sp_fma_1t(mydata);
+        case FUNC_SKL_COREI_SP_FMA_2T:
+            return asm_work_skl_corei_sp_fma_2t(mydata);
+        case FUNC_SKL_COREI_INT16_FMA_1T:
+            return asm_work_skl_corei_int16_fma_1t(mydata);
+        case FUNC_SKL_COREI_INT16_FMA_2T:
+            return asm_work_skl_corei_int16_fma_2t(mydata);
+        case FUNC_SKL_COREI_INT8_FMA_1T:
+            return asm_work_skl_corei_int8_fma_1t(mydata);
+        case FUNC_SKL_COREI_INT8_FMA_2T:
+            return asm_work_skl_corei_int8_fma_2t(mydata);
+        case FUNC_SKL_COREI_BF16_FMA_1T:
+            return asm_work_skl_corei_bf16_fma_1t(mydata);
+        case FUNC_SKL_COREI_BF16_FMA_2T:
+            return asm_work_skl_corei_bf16_fma_2t(mydata);
+        case FUNC_SKL_COREI_U288_FMA_1T:
+            return asm_work_skl_corei_u288_fma_1t(mydata);
+        case FUNC_SKL_COREI_U288_FMA_2T:
+            return asm_work_skl_corei_u288_fma_2t(mydata);
+        case FUNC_SKL_COREI_U576_FMA_1T:
+            return asm_work_skl_corei_u576_fma_1t(mydata);
+        case FUNC_SKL_COREI_U576_FMA_2T:
+            return asm_work_skl_corei_u576_fma_2t(mydata);
+        case FUNC_SKL_COREI_U1152_FMA_1T:
+            return asm_work_skl_corei_u1152_fma_1t(mydata);
+        case FUNC_SKL_COREI_U1152_FMA_2T:
+            return asm_work_skl_corei_u1152_fma_2t(mydata);
+        case FUNC_MEM_NTSTORE_SSE2:
+            return asm_work_mem_ntstore_sse2(mydata);
+        case FUNC_MEM_READ_SSE2:
+            return asm_work_mem_read_sse2(mydata);
+        case FUNC_MEM_COPY_SSE2:
+            return asm_work_mem_copy_sse2(mydata);
+        case FUNC_MEM_TRIAD_SSE2:
+            return asm_work_mem_triad_sse2(mydata);
+        case FUNC_COH_ATOMIC:
+            return asm_work_coh_atomic(mydata);
+        case FUNC_COH_PINGPONG:
+            return asm_work_coh_pingpong(mydata);
+        case FUNC_COH_QUEUE:
+            return asm_work_coh_queue(mydata);
+        default:
+            fprintf(stderr,"Error: unknown function %i\n",mydata->FUNCTION);
+            pthread_exit(NULL);
+    }
+}
+
+/*
+ * determine the number of loop iterations that executes in mydata->chunk_us usec
+ * by timing calls with an increasing number of iterations
+ */
+static void calibrate_chunk(threaddata_t *mydata)
+{
+    unsigned long long iterations = mydata->iterations;
+    unsigned long long target = mydata->data->cpuinfo->clockrate / 1000000 * CHUNK_CALIBRATION_USEC;
+    unsigned long long start, delta = 0;
+    unsigned long long chunk = 1;
+    unsigned long long addrHigh = mydata->addrHigh;
+    volatile unsigned long long high = LOAD_HIGH;
+
+    /* the payload only runs for the requested number of iterations while the load level is high,
+     * the calls see a private high level, so the calibration does not depend on the phase of -l */
+    mydata->addrHigh = (unsigned long long) &high;
+    while (1){
+        mydata->chunk = chunk;
+        start = timestamp();
+        call_asm_work(mydata);
+        delta = timestamp() - start;
+        if ((delta >= target) || (chunk >= (1ULL << 40))) break;
+        chunk *= 2;
+    }
+    mydata->addrHigh = addrHigh;
+    mydata->iterations = iterations;
+
+    chunk = (unsigned long long)((double)chunk * (double)mydata->chunk_us * (double)mydata->data->cpuinfo->clockrate / 1000000.0 / (double)delta);
+    mydata->chunk = chunk ? chunk : 1;
+}
+
 /*
  * function that performs the stress test
  */
@@ -191,7 +743,7 @@ void *thread(void *threaddata)
     int id = ((threaddata_t *)threaddata)->thread_id;
     volatile mydata_t *global_data = ((threaddata_t *)threaddata)->data; //communication with master thread
     threaddata_t *mydata = (threaddata_t *)threaddata;
-    unsigned int tmp = 0;
+    unsigned int tmp = 0, k;
     unsigned long long old = THREAD_STOP;
 
     /* wait untill master thread starts initialization */
@@ -220,65 +772,27 @@ void *thread(void *threaddata)
                         global_data->ack = id + 1; 
                     }
 
-                    /* call init function */
-                    switch (mydata->FUNCTION)
-                    {
-                        case FUNC_KNL_XEONPHI_AVX512_4T:
-                            tmp = init_knl_xeonphi_avx512_4t(mydata);
-                            break;
-                        case FUNC_SKL_COREI_FMA_1T:
-                            tmp = init_skl_corei_fma_1t(mydata);
-                            break;
-                        case FUNC_SKL_COREI_FMA_2T:
-                            tmp = init_skl_corei_fma_2t(mydata);
-                            break;
-                        case FUNC_HSW_COREI_FMA_1T:
-                            tmp = init_hsw_corei_fma_1t(mydata);
-                            break;
-                        case FUNC_HSW_COREI_FMA_2T:
-                            tmp = init_hsw_corei_fma_2t(mydata);
-                            break;
-                        case FUNC_HSW_XEONEP_FMA_1T:
-                            tmp = init_hsw_xeonep_fma_1t(mydata);
-                            break;
-                        case FUNC_HSW_XEONEP_FMA_2T:
-                            tmp = init_hsw_xeonep_fma_2t(mydata);
-                            break;
-                        case FUNC_SNB_COREI_AVX_1T:
-                            tmp = init_snb_corei_avx_1t(mydata);
-                            break;
-                        case FUNC_SNB_COREI_AVX_2T:
-                            tmp = init_snb_corei_avx_2t(mydata);
-                            break;
-                        case FUNC_SNB_XEONEP_AVX_1T:
-                            tmp = init_snb_xeonep_avx_1t(mydata);
-                            break;
-                        case FUNC_SNB_XEONEP_AVX_2T:
-                            tmp = init_snb_xeonep_avx_2t(mydata);
-                            break;
-                        case FUNC_NHM_COREI_SSE2_1T:
-                            tmp = init_nhm_corei_sse2_1t(mydata);
-                            break;
-                        case FUNC_NHM_COREI_SSE2_2T:
-                            tmp = init_nhm_corei_sse2_2t(mydata);
-                            break;
-                        case FUNC_NHM_XEONEP_SSE2_1T:
-                            tmp = init_nhm_xeonep_sse2_1t(mydata);
-                            break;
-                        case FUNC_NHM_XEONEP_SSE2_2T:
-                            tmp = init_nhm_xeonep_sse2_2t(mydata);
-                            break;
-                        case FUNC_BLD_OPTERON_FMA4_1T:
-                            tmp = init_bld_opteron_fma4_1t(mydata);
-                            break;
-                        default:
-                            fprintf(stderr, "Error: unknown function %i\n", mydata->FUNCTION);
-                            pthread_exit(NULL);
+                    /* call init function, for --sweep once per function, ending with the first one */
+                    if (mydata->num_sweep){
+                        for (k = mydata->num_sweep; k-- > 0;){
+                            mydata->FUNCTION = mydata->sweep[k];
+                            tmp = call_init(mydata);
+                            if (tmp != EXIT_SUCCESS) break;
+                            mydata->sweepdata[k].flops = mydata->flops;
+                            mydata->sweepdata[k].bytes = mydata->bytes;
+                            memcpy(mydata->sweepdata[k].reset_count, mydata->reset_count, sizeof(mydata->reset_count));
+                        }
                     }
+                    else tmp = call_init(mydata);
                     if (tmp != EXIT_SUCCESS){
                         fprintf(stderr, "Error in function %i\n", mydata->FUNCTION);
                         pthread_exit(NULL);
                     } 
+                    if (mydata->data_pattern != PATTERN_DEFAULT) fill_data_pattern(mydata);
+                    if (init_secondary(mydata) != EXIT_SUCCESS){
+                        fprintf(stderr, "Error: initialization of secondary workload %s failed\n", secondary_workloads[mydata->secondary].name);
+                        pthread_exit(NULL);
+                    }
 
                 }
                 else{
@@ -297,55 +811,31 @@ void *thread(void *threaddata)
                     /* will be terminated by watchdog 
                      * watchdog also alters mydata->addrHigh to switch between high and low load function
                      */
-					FILE *config = fopen("fsconfig", "r");
-					unsigned long NUM_FS_WORKLOADS = 0;
-					unsigned long NUM_SLEEP_WORKLOADS = 0;
-					unsigned long iteration_cap = (unsigned long) NUM_ITERS;
-					unsigned sec = SECONDS, usec = 50;
-					double watts = WATTS, uwatts = 120;
-					unsigned long freq = 0x2D00;
-					double maxfreq = 4.2;
-					unsigned duty = 8800;
-					unsigned partitions = 4;
-					char turbo = 't';
-					if (config == NULL)
-					{
-							fprintf(stderr, "Error opening config file, using defaults\n");
-					}
-					else
-					{
-						fscanf(config, "%lu\n", &iteration_cap);
-						fscanf(config, "%u\n", &sec);
-						fscanf(config, "%lf\n", &watts);
-						fscanf(config, "%u\n", &usec);
-						fscanf(config, "%lf\n", &uwatts);
-						fscanf(config, "%lx\n", &freq);
-						fscanf(config, "%c\n", &turbo);	
-						fscanf(config, "%u\n", &duty);	
-						fscanf(config, "%u\n", &partitions);	
-						fscanf(config, "%lf", &maxfreq);
-						fscanf(config, "%lu", &NUM_FS_WORKLOADS);
-						fscanf(config, "%lu", &NUM_SLEEP_WORKLOADS);
-						freq &= 0xFFFFUL;
-						fprintf(stderr, "Using Config: %lu, %u, %lf, %u, %lf, %lx, %c, %u, %u, %lf\n",
-						iteration_cap, sec, watts, usec, uwatts, freq, turbo, duty, partitions, maxfreq);
-						fclose(config);
-					}
+					/* run configuration, read and validated once in main() */
+					const fsconfig_t *config = ((threaddata_t *) threaddata)->config;
+					unsigned long iteration_cap = config->iterations;
+					double sec = config->pl1_window;
+					unsigned usec = config->pl2_window;
+					double watts = config->pl1_power, uwatts = config->pl2_power;
+					double maxfreq = config->maxfreq;
+					unsigned duty = config->duty;
 					unsigned long num_iters = 0;
-					if (((threaddata_t *) threaddata)->msrdata == NULL)
+					if (((threaddata_t *) threaddata)->msrdata_size < iteration_cap)
 					{
+							free(((threaddata_t *) threaddata)->msrdata);
 							((threaddata_t *) threaddata)->msrdata = (msrdata_t *) malloc(iteration_cap * sizeof(msrdata_t));
+							((threaddata_t *) threaddata)->msrdata_size = iteration_cap;
 							if (((threaddata_t *) threaddata)->msrdata == NULL)
 							{
 								printf("ERROR: thread %u unable to allocate\n", ((threaddata_t *) threaddata)->cpu_id);
 							}
-							((threaddata_t *) threaddata)->iter = 0;
 					}
+					((threaddata_t *) threaddata)->iter = 0;
 					int res;
 					uint64_t perfstat, inst_ret, inst_ret_a;
 					uint64_t low, high, low_a, high_a;
 					uint64_t energy, energy_a, pp0, pp0_a;
-					uint64_t aperf, aperf_a, mperf, mperf_a, perf;
+					uint64_t aperf, aperf_a, mperf, mperf_a;
 					uint64_t mperf_tot, aperf_tot, mperf_tot_a, aperf_tot_a;
 					struct timeval before_time;
 					unsigned affinity = ((threaddata_t *) threaddata)->cpu_id;
@@ -366,44 +856,19 @@ void *thread(void *threaddata)
 
 					//struct timeval profa, profb;
 					gettimeofday(&before_time, NULL);
-					double pu, su;
-					if (affinity == 0)
+					// every thread requests its own P-state (pstate of the run configuration or --pstate)
+					perf_set(mydata, mydata->pstate);
+					double pu = 0.0, su = 0.0;
+					if (mydata->thread_id == 0)
 					{
 						//gettimeofday(&profb, NULL);
-						uint64_t old_perf;
-#ifdef MCK
-						syscall(READ, PERF_CTL, &old_perf);
-#endif
-#ifndef MCK
-						read_msr_by_coord(0, affinity, msr_thread, PERF_CTL, &old_perf);
-#endif
-						//disable turbo
-						//perf = perf | 0x100000000UL;
-						// this enables turbo
-						//perf = perf & (~0x100000000UL);
-						if (turbo == 't')
-						{
-							perf = (old_perf & 
-								0xFFFFFFFEFFFF0000UL) |
-								(freq & 0xFFFFUL);
-						}
-						else
-						{
-							perf = (old_perf & 
-								0xFFFFFFFFFFFF0000UL) |
-								(freq & 0xFFFFUL) | 
-								0x100000000UL;
-						}
-
 #ifdef MCK
-						syscall(WRITE, PERF_CTL, &perf);
 						syscall(READ, ENERGY_STATUS, &energy);
 						syscall(READ, ENERGY_PP0, &pp0);
 						syscall(READ, APERF, &aperf_tot);
 						syscall(READ, MPERF, &mperf_tot);
 #endif
 #ifndef MCK
-						write_msr_by_coord(0, affinity, msr_thread, PERF_CTL, perf);
 						read_msr_by_coord(0, affinity, msr_thread, ENERGY_STATUS, &energy);
 						read_msr_by_coord(0, affinity, msr_thread, ENERGY_PP0, &pp0);
 						read_msr_by_coord(0, affinity, msr_thread, APERF, &aperf_tot);
@@ -420,16 +885,6 @@ void *thread(void *threaddata)
 						uint64_t seconds;
 						uint64_t timeval_y = 0, timeval_x = 0;
 						double logremainder = 0;
-						if (sec > 40)
-						{
-							fprintf(stderr, "ERROR: seconds too high\n");
-							//sec = 40;
-						}
-						if (usec > 127)
-						{
-							fprintf(stderr, "ERROR: usec too high\n");
-							usec = 127;
-						}
 						timeval_y = (uint64_t) log2(sec / su);
 						fprintf(stderr, "time unit is %lf, field 1 is %lx\n", su, timeval_y);
 						// store the mantissa of the log2
@@ -488,9 +943,31 @@ void *thread(void *threaddata)
 					unsigned enr_samp_counter = 0;
 					double *pow_dat = (double *) calloc(1024, sizeof(double));
 					struct timeval psamp_b, psamp_a;
-					// start the state at one since itr starts at 1
-					short state = 1;
 					uint64_t last = 0;
+					// phase sequence of --phases, or payload and secondary partitions of the run configuration
+					phase_step_t default_steps[PHASE_DEFAULT_STEPS];
+					phase_seq_t default_seq;
+					const phase_seq_t *seq = global_data->phases;
+					if (seq == NULL)
+					{
+						phases_default(&default_seq, default_steps, config, mydata->secondary, mydata->numthreads);
+						seq = &default_seq;
+					}
+					mydata->phase_arrivals = 0;
+					mydata->phase_log_num = 0;
+					memset(mydata->efficiency_iterations, 0, sizeof(mydata->efficiency_iterations));
+					memset(mydata->efficiency_flops, 0, sizeof(mydata->efficiency_flops));
+					memset(mydata->efficiency_bytes, 0, sizeof(mydata->efficiency_bytes));
+					throttle_start(mydata);
+					if (mydata->thread_id == 0)
+					{
+						global_data->phase_stop = 0;
+						global_data->phase_arrived = 0;
+						global_data->phase_samples_sum = 0;
+						global_data->phase_iterations_sum = 0;
+						global_data->phase_flops_sum = 0;
+						global_data->phase_bytes_sum = 0;
+					}
 #ifdef MCK
 					syscall(READ, ENERGY_STATUS, &last);
 #endif
@@ -498,22 +975,86 @@ void *thread(void *threaddata)
 					read_msr_by_coord(0, affinity, msr_thread, ENERGY_STATUS, &last);
 #endif
 
+					if (((threaddata_t *) threaddata)->chunk_us)
+					{
+						calibrate_chunk((threaddata_t *) threaddata);
+						if (mydata->thread_id == 0)
+						{
+							fprintf(stderr, "chunk: %llu iterations (%llu usec)\n",
+								((threaddata_t *) threaddata)->chunk, ((threaddata_t *) threaddata)->chunk_us);
+						}
+					}
+
 					gettimeofday(&psamp_b, NULL);
+					if (mydata->thread_id == 0 && mydata->data->num_pstates)
+					{
+						mydata->data->pstate_measure = timestamp() + (unsigned long long) (PSTATE_SETTLE * (double) mydata->data->dwell_tsc);
+						mydata->data->pstate_deadline = timestamp() + mydata->data->dwell_tsc;
+					}
 										
 					// barrier to keep threads in sync
 					barrier(affinity, ((threaddata_t *)threaddata));
+					if (mydata->data->num_pstates) pstate_switch(mydata);
+					// --rapl-schedule: the offsets of the steps start here
+					powercap_t *powercap = mydata->data->powercap;
+					if (mydata->thread_id == 0 && powercap)
+					{
+						powercap_start(powercap, mydata->data, mydata->package, timestamp());
+					}
+					int entered = phase_transition(mydata, seq, 1, pu, su, energy_unit);
+					const phase_step_t *step = &seq->steps[mydata->phase_pc];
+					if (mydata->thread_id == 0 && mydata->num_sweep && (entered > 0) && (step->workload == 0))
+					{
+						sweep_account_energy(mydata, energy_unit, 1);
+					}
 										
-					for (num_iters = 0; num_iters < iteration_cap; num_iters++) 
+					for (num_iters = 0; entered > 0; num_iters++) 
 					{
+						// a full sample buffer ends the run at the next transition
+						if (num_iters == iteration_cap) global_data->phase_stop = 1;
+						// a step ends after its samples or at its TSC deadline, checked between two chunks
+						if (global_data->phase_stop || (step->samples && (mydata->phase_samples == step->samples))
+							|| ((step->seconds > 0.0) && (timestamp() >= mydata->phase_deadline)))
+						{
+							// --sweep: the interval of the function ends with its payload step
+							if (mydata->thread_id == 0 && mydata->num_sweep && (step->workload == 0))
+							{
+								sweep_account_energy(mydata, energy_unit, 0);
+							}
+							entered = phase_transition(mydata, seq, 0, pu, su, energy_unit);
+							if (entered <= 0) break;
+							step = &seq->steps[mydata->phase_pc];
+							// --sweep: each payload step runs the next function
+							if (step->workload == 0 && mydata->num_sweep)
+							{
+								mydata->sweep_pos = (mydata->sweep_pos + 1) % mydata->num_sweep;
+								mydata->FUNCTION = mydata->sweep[mydata->sweep_pos];
+								mydata->flops = mydata->sweepdata[mydata->sweep_pos].flops;
+								mydata->bytes = mydata->sweepdata[mydata->sweep_pos].bytes;
+								memcpy(mydata->reset_count, mydata->sweepdata[mydata->sweep_pos].reset_count, sizeof(mydata->reset_count));
+								if (mydata->thread_id == 0)
+								{
+									sweep_account_energy(mydata, energy_unit, 1);
+								}
+							}
+						}
+						mydata->phase_samples++;
+						workload = (step->workload != 0);
 						((threaddata_t *) threaddata)->iter++;
 						if (!(((threaddata_t *) threaddata)->iter % (duty / 8)))
 						{
-							// barrier to keep threads in sync
-							barrier(affinity, ((threaddata_t *)threaddata));
-							//if (affinity == 0)
-							//{
-							//	set_rapl(((threaddata_t *) threaddata)->iter % 20, 83.0, pu, su);
-							//}
+							// --pstate-sweep: the first thread decides before the barrier, all threads follow after it
+							if (mydata->thread_id == 0 && mydata->data->num_pstates)
+							{
+								pstate_advance(mydata, energy_unit);
+							}
+							// barrier to keep threads in sync, only if all of them take the same samples
+							if (seq->uniform) barrier(affinity, ((threaddata_t *)threaddata));
+							if (mydata->data->num_pstates)
+							{
+								if (mydata->data->pstate_current == mydata->data->num_pstates) break;
+								if (mydata->pstate_pos != mydata->data->pstate_current) pstate_switch(mydata);
+							}
 							uint64_t enr;
 #ifdef MCK
 							syscall(READ, ENERGY_STATUS, &enr);
@@ -530,23 +1071,6 @@ void *thread(void *threaddata)
 							last = enr;
 							psamp_b = psamp_a;
 						}
-						// 75% duty
-						if (!(((threaddata_t *) threaddata)->iter % (duty / partitions)))
-						{
-							state++;
-							if (state <= NUM_FS_WORKLOADS)
-							{
-								workload = 0;
-							}
-							else if ((state - NUM_FS_WORKLOADS) <= NUM_SLEEP_WORKLOADS)
-							{
-								workload = 1;
-							}
-							if (state >= NUM_FS_WORKLOADS + NUM_SLEEP_WORKLOADS)
-							{
-								state = 0;
-							}
-						}
 						if (workload == 1)
 						{
 #ifdef MCK
@@ -561,7 +1085,7 @@ void *thread(void *threaddata)
 #endif
 							__asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
 							//usleep(220);
-							res = intload();
+							res = secondary_work(mydata);
 #ifdef MCK
 							syscall(READ, PERF_STAT, &perfstat);
 							syscall(READ, APERF, &aperf_a);
@@ -583,10 +1107,17 @@ void *thread(void *threaddata)
 							ptr->aperf = aperf_a - aperf;
 							ptr->mperf = mperf_a - mperf;
 							ptr->retired = inst_ret_a - inst_ret;
-							ptr->log = 0;
+							ptr->log = powercap ? powercap->current : 0;
 							ptr->pmc0 = 0xFFFF & perfstat;
+							ptr->pmc1 = 0;
 							ptr->pmc2 = res;
-							ptr->pmc3 = workload;
+							ptr->pmc3 = mydata->secondary;
+							ptr->phase = mydata->phase_pc;
+							throttle_sample(mydata, ptr, after - before, aperf_a - aperf, mperf_a - mperf);
+							mydata->phase_iterations[PHASE_SECONDARY] += secondary_workloads[mydata->secondary].iterations;
+							mydata->phase_tsc[PHASE_SECONDARY] += after - before;
+							mydata->secondary_iterations[mydata->secondary] += secondary_workloads[mydata->secondary].iterations;
+							mydata->secondary_tsc[mydata->secondary] += after - before;
 							continue;
 						}
 					//while(1)
@@ -610,60 +1141,8 @@ void *thread(void *threaddata)
 #endif
 						__asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
 						res = 0x12345;
-						switch (mydata->FUNCTION)
-						{
-							case FUNC_KNL_XEONPHI_AVX512_4T:
-								tmp = asm_work_knl_xeonphi_avx512_4t(mydata);
-								break;
-							case FUNC_SKL_COREI_FMA_1T:
-								tmp = asm_work_skl_corei_fma_1t(mydata);
-								break;
-							case FUNC_SKL_COREI_FMA_2T:
-								tmp = asm_work_skl_corei_fma_2t(mydata);
-								break;
-							case FUNC_HSW_COREI_FMA_1T:
-								tmp = asm_work_hsw_corei_fma_1t(mydata);
-								break;
-							case FUNC_HSW_COREI_FMA_2T:
-								tmp = asm_work_hsw_corei_fma_2t(mydata);
-								break;
-							case FUNC_HSW_XEONEP_FMA_1T:
-								tmp = asm_work_hsw_xeonep_fma_1t(mydata);
-								break;
-							case FUNC_HSW_XEONEP_FMA_2T:
-								tmp = asm_work_hsw_xeonep_fma_2t(mydata);
-								break;
-							case FUNC_SNB_COREI_AVX_1T:
-								tmp = asm_work_snb_corei_avx_1t(mydata);
-								break;
-							case FUNC_SNB_COREI_AVX_2T:
-								tmp = asm_work_snb_corei_avx_2t(mydata);
-								break;
-							case FUNC_SNB_XEONEP_AVX_1T:
-								tmp = asm_work_snb_xeonep_avx_1t(mydata);
-								break;
-							case FUNC_SNB_XEONEP_AVX_2T:
-								tmp = asm_work_snb_xeonep_avx_2t(mydata);
-								break;
-							case FUNC_NHM_COREI_SSE2_1T:
-								tmp = asm_work_nhm_corei_sse2_1t(mydata);
-								break;
-							case FUNC_NHM_COREI_SSE2_2T:
-								tmp = asm_work_nhm_corei_sse2_2t(mydata);
-								break;
-							case FUNC_NHM_XEONEP_SSE2_1T:
-								tmp = asm_work_nhm_xeonep_sse2_1t(mydata);
-								break;
-							case FUNC_NHM_XEONEP_SSE2_2T:
-								tmp = asm_work_nhm_xeonep_sse2_2t(mydata);
-								break;
-							case FUNC_BLD_OPTERON_FMA4_1T:
-								tmp = asm_work_bld_opteron_fma4_1t(mydata);
-								break;
-							default:
-								fprintf(stderr,"Error: unknown function %i\n",mydata->FUNCTION);
-								pthread_exit(NULL);
-						}
+						unsigned long long iterations = mydata->iterations;
+						tmp = call_asm_work(mydata);
 #ifdef MCK
 						syscall(READ, PERF_STAT, &perfstat);
 						syscall(READ, APERF, &aperf_a);
@@ -684,11 +1163,32 @@ void *thread(void *threaddata)
 						ptr->tsc = after - before;
 						ptr->aperf = aperf_a - aperf;
 						ptr->mperf = mperf_a - mperf;
-						ptr->log = 0;
+						ptr->log = powercap ? powercap->current : 0; // applied steps of --rapl-schedule
 						ptr->retired = inst_ret_a - inst_ret;
 						ptr->pmc0 = 0xFFFF & perfstat;
+						ptr->pmc1 = mydata->FUNCTION;
 						ptr->pmc2 = res; // dummy value to prevent optimization
 						ptr->pmc3 = workload;
+						ptr->phase = mydata->phase_pc;
+						throttle_sample(mydata, ptr, after - before, aperf_a - aperf, mperf_a - mperf);
+						mydata->phase_iterations[PHASE_PAYLOAD] += mydata->iterations - iterations;
+						mydata->phase_tsc[PHASE_PAYLOAD] += after - before;
+						if (mydata->data->num_pstates && (before >= mydata->data->pstate_measure))
+						{
+							sweepdata_t *pstate = &mydata->pstatedata[mydata->pstate_pos];
+							pstate->iterations += mydata->iterations - iterations;
+							pstate->tsc += after - before;
+							pstate->aperf += aperf_a - aperf;
+							pstate->mperf += mperf_a - mperf;
+						}
+						if (mydata->num_sweep)
+						{
+							sweepdata_t *sweep = &mydata->sweepdata[mydata->sweep_pos];
+							sweep->iterations += mydata->iterations - iterations;
+							sweep->tsc += after - before;
+							sweep->aperf += aperf_a - aperf;
+							sweep->mperf += mperf_a - mperf;
+						}
 						/*
 						((threaddata_t *) threaddata)->msrdata[((threaddata_t *) threaddata)->iter - 1].tsc = after - before;
 						((threaddata_t *) threaddata)->msrdata[((threaddata_t *) threaddata)->iter - 1].aperf = aperf_a - aperf;
@@ -703,6 +1203,9 @@ void *thread(void *threaddata)
 							pthread_exit(NULL);
 						}
 
+						/* --verify: known-answer run of the payload, compared with the reference of the first CPU */
+						if (mydata->verify_tsc && (timestamp() >= mydata->verify_next)) verify_payload(mydata);
+
 						/* call low load function */
 						#ifdef ENABLE_VTRACING
 						VT_USER_END("HIGH_LOAD_FUNC");
@@ -723,6 +1226,7 @@ void *thread(void *threaddata)
 						/* terminate if master signals end of run */
 						if(*((volatile unsigned long long *)(mydata->addrHigh)) == LOAD_STOP) {
 							((threaddata_t *)threaddata) -> stop_tsc = timestamp();
+							perf_restore(mydata);
 
 							pthread_exit(NULL);
 						}
@@ -731,13 +1235,42 @@ void *thread(void *threaddata)
 			//printf("%d: proftime %lfus\n", affinity, tprof);
 				
 					} // end while
+					// the phase sequence and --pstate-sweep end the loop early, only the recorded samples are written
+					unsigned long samples = num_iters;
+					((threaddata_t *)threaddata)->stop_tsc = timestamp();
+					perf_restore(mydata);
+					// the end transition restores POWER_LIMIT, --pstate-sweep and the watchdog leave the loop without it
+					if ((mydata->thread_id == 0) && seq->caps && (entered != 0))
+					{
+						msrio_write(affinity, POWER_LIMIT, global_data->phase_limit);
+					}
+					if (entered < 0)
+					{
+						pthread_exit(NULL);
+					}
+					if (mydata->thread_id == 0)
+					{
+						// --pstate-sweep leaves the loop without a transition
+						if (entered > 0) phase_log(mydata, seq, seq->num_steps, energy_unit);
+						char trace[320];
+						snprintf(trace, sizeof(trace), "%s%s", global_data->run_dir, PHASES_TRACE);
+						phases_report(stdout, seq, mydata->phase_log, mydata->phase_log_num, mydata->data->cpuinfo->clockrate, trace);
+						snprintf(trace, sizeof(trace), "%s%s", global_data->run_dir, PHASES_EFFICIENCY);
+						phases_efficiency(stdout, global_data->threaddata, global_data->num_threads, mydata, phase_packages(mydata),
+							mydata->data->cpuinfo->clockrate, trace);
+						throttle_report(stdout, global_data->threaddata, global_data->num_threads, mydata->data->cpuinfo->clockrate);
+					}
+					if (mydata->thread_id == 0 && mydata->num_sweep)
+					{
+						sweep_account_energy(mydata, energy_unit, 0);
+					}
 					printf("finished workload");
 					fflush(stdout);
 					unsigned long delta_joules, delta_pp0;
 					struct timeval after_time;
 					gettimeofday(&after_time, NULL);
 					double time = (after_time.tv_sec - before_time.tv_sec) + (after_time.tv_usec - before_time.tv_usec) / 1000000.0;
-					if (affinity == 0)
+					if (mydata->thread_id == 0)
 					{ 
 						printf("energy unit is: %lf\n", energy_unit);
 #ifdef MCK
@@ -811,13 +1344,13 @@ void *thread(void *threaddata)
 					printf("writing data\n");
 					printf("thread %u time: %lf\n", affinity, time);
 					fflush(stdout);
-					char fname[64];
-					snprintf(fname, 64, "core%d.msrdat", affinity);
+					char fname[320];
+					snprintf(fname, sizeof(fname), "%score%d.msrdat", global_data->run_dir, affinity);
 					FILE * out = fopen(fname, "w");
-					fprintf(out, "tsc\tretired\taperf\tmperf\tfreq\tlog\tstat\tworkload\n");
-					for (num_iters = 0; num_iters < iteration_cap; num_iters++)
+					fprintf(out, "tsc\tretired\taperf\tmperf\tfreq\tlog\tstat\tworkload\tfunction\tphase\tlimits\tlabel\n");
+					for (num_iters = 0; num_iters < samples; num_iters++)
 					{
-					fprintf(out, "%lu\t%lu\t%lu\t%lu\t%.1lf\t%lx\t%lx\t%lu\n",
+					fprintf(out, "%lu\t%lu\t%lu\t%lu\t%.1lf\t%lx\t%lx\t%lu\t%lu\t%lu\t%lx\t%s\n",
 						((threaddata_t *) threaddata)->msrdata[num_iters].tsc,
 						((threaddata_t *) threaddata)->msrdata[num_iters].retired,
 						((threaddata_t *) threaddata)->msrdata[num_iters].aperf,
@@ -827,13 +1360,15 @@ void *thread(void *threaddata)
 						maxfreq,
 						((threaddata_t *) threaddata)->msrdata[num_iters].log,
 						((threaddata_t *) threaddata)->msrdata[num_iters].pmc0,
-						((threaddata_t *) threaddata)->msrdata[num_iters].pmc3);
-						//((threaddata_t *) threaddata)->msrdata[num_iters].pmc1);
+						((threaddata_t *) threaddata)->msrdata[num_iters].pmc3,
+						((threaddata_t *) threaddata)->msrdata[num_iters].pmc1,
+						((threaddata_t *) threaddata)->msrdata[num_iters].phase,
+						((threaddata_t *) threaddata)->msrdata[num_iters].limits,
+						secondary_workloads[((threaddata_t *) threaddata)->msrdata[num_iters].pmc3].name);
 					}
 					fflush(out);
 					fclose(out);
-					free(((threaddata_t *) threaddata)->msrdata);
-					snprintf(fname, 64, "core%d.pow", affinity);
+					snprintf(fname, sizeof(fname), "%score%d.pow", global_data->run_dir, affinity);
 					out = fopen(fname, "w");
 					unsigned itr = 0;
 					while (pow_dat[itr] != 0)
@@ -843,10 +1378,18 @@ void *thread(void *threaddata)
 					}
 					free(pow_dat);
 					fclose(out);
-					if (affinity == 0)
+					if (mydata->thread_id == 0)
 					{
+						if (powercap) powercap_stop(powercap);
 						disable_rapl();
 					}
+					// --campaign: keep the buffers and wait until the next run is started
+					if (global_data->campaign)
+					{
+						__sync_fetch_and_add(&global_data->run_done, 1);
+						break;
+					}
+					free(((threaddata_t *) threaddata)->msrdata);
 					pthread_exit(NULL);
                 }
                 else{
@@ -870,22 +1413,3 @@ void *thread(void *threaddata)
         } 
     }
 }
-
-int intload()
-{
-	int a, b, c;
-	unsigned itr;
-	for (itr = 0; itr < 550000; itr++)
-	{
-		__asm__ __volatile__(
-			"addq %%rdx, %%rax\n\t"
-			"addq %%rax, %%rbx\n\t"
-			"addq %%rbx, %%rcx\n\t"
-			: "=a" (a), "=b" (b), "=c" (c)
-			: "d" (itr)
-			:
-		);
-	}
-	return a | b | c;
-}
-
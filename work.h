@@ -44,6 +44,60 @@
 #define FUNC_NHM_XEONEP_SSE2_1T        14
 #define FUNC_NHM_XEONEP_SSE2_2T        15
 #define FUNC_BLD_OPTERON_FMA4_1T       16
+#define FUNC_MEM_NTSTORE_SSE2          17
+#define FUNC_MEM_READ_SSE2             18
+#define FUNC_MEM_COPY_SSE2             19
+#define FUNC_MEM_TRIAD_SSE2            20
+#define FUNC_SKL_COREI_L1_FMA_1T       21
+#define FUNC_SKL_COREI_L1_FMA_2T       22
+#define FUNC_SKL_COREI_L2_FMA_1T       23
+#define FUNC_SKL_COREI_L2_FMA_2T       24
+#define FUNC_SKL_COREI_L3_FMA_1T       25
+#define FUNC_SKL_COREI_L3_FMA_2T       26
+#define FUNC_SKL_COREI_RAM_FMA_1T      27
+#define FUNC_SKL_COREI_RAM_FMA_2T      28
+#define FUNC_SKL_COREI_REG_FMA_1T      29
+#define FUNC_SKL_COREI_REG_FMA_2T      30
+#define FUNC_SKL_COREI_W128_FMA_1T     31
+#define FUNC_SKL_COREI_W128_FMA_2T     32
+#define FUNC_SKL_COREI_W512_FMA_1T     33
+#define FUNC_SKL_COREI_W512_FMA_2T     34
+#define FUNC_SKL_COREI_SP_FMA_1T       35
+#define FUNC_SKL_COREI_SP_FMA_2T       36
+#define FUNC_SKL_COREI_INT16_FMA_1T    37
+#define FUNC_SKL_COREI_INT16_FMA_2T    38
+#define FUNC_SKL_COREI_INT8_FMA_1T     39
+#define FUNC_SKL_COREI_INT8_FMA_2T     40
+#define FUNC_SKL_COREI_BF16_FMA_1T     41
+#define FUNC_SKL_COREI_BF16_FMA_2T     42
+#define FUNC_SKL_COREI_U288_FMA_1T     43
+#define FUNC_SKL_COREI_U288_FMA_2T     44
+#define FUNC_SKL_COREI_U576_FMA_1T     45
+#define FUNC_SKL_COREI_U576_FMA_2T     46
+#define FUNC_SKL_COREI_U1152_FMA_1T    47
+#define FUNC_SKL_COREI_U1152_FMA_2T    48
+#define FUNC_COH_ATOMIC                49
+#define FUNC_COH_PINGPONG              50
+#define FUNC_COH_QUEUE                 51
+
+#define IS_COHERENCE_FUNCTION(func)    (((func) >= FUNC_COH_ATOMIC) && ((func) <= FUNC_COH_QUEUE))
+
+/*
+ * buffer layout of the memory bandwidth functions: 3 arrays per thread
+ */
+#define MEM_ARRAYSIZE                  33554432
+#define MEM_BLOCKSIZE                  4096
+
+/*
+ * shared cache lines of the coherence functions: one area per group of threads, each member owns a queue of
+ * COH_QUEUE_LINES lines plus a head and a tail line, one iteration transfers COH_TRANSFERS cache lines
+ */
+#define COH_LINE                       64
+#define COH_MAX_GROUP                  8
+#define COH_QUEUE_LINES                16
+#define COH_QUEUE_BYTES                ((COH_QUEUE_LINES + 2) * COH_LINE)
+#define COH_GROUP_BYTES                (((COH_MAX_GROUP * COH_QUEUE_BYTES) + 4095) & ~4095ULL)
+#define COH_TRANSFERS                  64
 
 /*
  * function that does the measurement
@@ -55,6 +109,18 @@ extern void _work(volatile mydata_t* data, unsigned long long *high);
  */
 extern void *thread(void *threaddata);
 
+/*
+ * buffer sizes derived from the detected caches (work.c) and reset counters of the buffer pointers (init_functions.c)
+ */
+extern void cache_buffersizes(cpu_info_t *cpuinfo, unsigned int threads, unsigned int *buffersize);
+extern unsigned long long buffer_reset_count(unsigned long long size, double cover, unsigned int lines);
+
+/*
+ * call the init and high load functions selected by threaddata->FUNCTION
+ */
+extern int call_init(threaddata_t *mydata);
+extern int call_asm_work(threaddata_t *mydata);
+
 /*
  * init functions
  */
@@ -106,6 +172,104 @@ int init_nhm_xeonep_sse2_2t(threaddata_t* threaddata);
 int init_bld_opteron_fma4_1t(threaddata_t* threaddata) __attribute__((noinline));
 int init_bld_opteron_fma4_1t(threaddata_t* threaddata);
 
+int init_skl_corei_l1_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l1_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_l1_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l1_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_l2_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l2_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_l2_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l2_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_l3_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l3_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_l3_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_l3_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_ram_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_ram_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_ram_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_ram_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_reg_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_reg_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_reg_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_reg_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_w128_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w128_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_w128_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w128_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_w512_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w512_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_w512_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_w512_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_sp_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_sp_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_sp_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_sp_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_int16_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int16_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_int16_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int16_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_int8_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int8_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_int8_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_int8_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_bf16_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_bf16_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_bf16_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_bf16_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_u288_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u288_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_u288_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u288_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_u576_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u576_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_u576_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u576_fma_2t(threaddata_t* threaddata);
+
+int init_skl_corei_u1152_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u1152_fma_1t(threaddata_t* threaddata);
+
+int init_skl_corei_u1152_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int init_skl_corei_u1152_fma_2t(threaddata_t* threaddata);
+
+int init_mem_ntstore_sse2(threaddata_t* threaddata);
+
+int init_mem_read_sse2(threaddata_t* threaddata);
+
+int init_mem_copy_sse2(threaddata_t* threaddata);
+
+int init_mem_triad_sse2(threaddata_t* threaddata);
+
+int init_coh_atomic(threaddata_t* threaddata);
+
+int init_coh_pingpong(threaddata_t* threaddata);
+
+int init_coh_queue(threaddata_t* threaddata);
+
 
 /*
  * stress test functions
@@ -158,6 +322,111 @@ int asm_work_nhm_xeonep_sse2_2t(threaddata_t* threaddata);
 int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata) __attribute__((noinline));
 int asm_work_bld_opteron_fma4_1t(threaddata_t* threaddata);
 
+int asm_work_skl_corei_l1_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_l1_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_l1_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_l1_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_l2_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_l2_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_l2_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_l2_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_l3_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_l3_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_l3_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_l3_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_ram_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_ram_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_ram_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_ram_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_reg_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_reg_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_reg_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_reg_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_w128_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_w128_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_w128_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_w128_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_w512_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_w512_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_w512_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_w512_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_sp_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_sp_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_sp_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_sp_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_int16_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_int16_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_int16_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_int16_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_int8_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_int8_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_int8_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_int8_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_bf16_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_bf16_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_bf16_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_bf16_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_u288_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_u288_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_u288_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_u288_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_u576_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_u576_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_u576_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_u576_fma_2t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_u1152_fma_1t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_u1152_fma_1t(threaddata_t* threaddata);
+
+int asm_work_skl_corei_u1152_fma_2t(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_skl_corei_u1152_fma_2t(threaddata_t* threaddata);
+
+int asm_work_mem_ntstore_sse2(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_mem_ntstore_sse2(threaddata_t* threaddata);
+
+int asm_work_mem_read_sse2(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_mem_read_sse2(threaddata_t* threaddata);
+
+int asm_work_mem_copy_sse2(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_mem_copy_sse2(threaddata_t* threaddata);
+
+int asm_work_mem_triad_sse2(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_mem_triad_sse2(threaddata_t* threaddata);
+
+int asm_work_coh_atomic(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_coh_atomic(threaddata_t* threaddata);
+
+int asm_work_coh_pingpong(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_coh_pingpong(threaddata_t* threaddata);
+
+int asm_work_coh_queue(threaddata_t* threaddata) __attribute__((noinline));
+int asm_work_coh_queue(threaddata_t* threaddata);
+
 
 /*
  * low load function
@@ -519,6 +519,15 @@ int get_cpu_isa_extensions(char* features, size_t len)
             
             if (b&(1<<5))  strncat(features,"AVX2 ", (len-strlen(features))-1);
             if (b&(1<<16)) strncat(features,"AVX512 ", (len-strlen(features))-1);
+            /* the extensions below are only reported if they support 256 bit registers (AVX512VL) */
+            if ((b&(1UL<<31)) && (c&(1<<11))) strncat(features,"AVX512_VNNI ", (len-strlen(features))-1);
+            if ((b&(1UL<<31)) && (a>=1))
+            {
+                a=7;c=1;
+                cpuid(&a,&b,&c,&d);
+
+                if (a&(1<<5)) strncat(features,"AVX512_BF16 ", (len-strlen(features))-1);
+            }
         }
         if (max_ext>=0x80000001)
         {